@@ -53,7 +53,7 @@ config_freebsd() {
 	: ${LLVM_CONFIG=/usr/local/bin/llvm-config11}
 
 	CXXFLAGS="$CXXFLAGS $($LLVM_CONFIG --cxxflags --ldflags)"
-	LDFLAGS="$LDFLAGS $($LLVM_CONFIG --libs core native --system-libs)"
+	LDFLAGS="$LDFLAGS $($LLVM_CONFIG --libs core native linker bitreader bitwriter --system-libs)"
 }
 
 config_openbsd() {
@@ -61,7 +61,7 @@ config_openbsd() {
 
 	LDFLAGS="$LDFLAGS -liconv"
 	CXXFLAGS="$CXXFLAGS $($LLVM_CONFIG --cxxflags --ldflags)"
-	LDFLAGS="$LDFLAGS $($LLVM_CONFIG --libs core native --system-libs)"
+	LDFLAGS="$LDFLAGS $($LLVM_CONFIG --libs core native linker bitreader bitwriter --system-libs)"
 }
 
 config_linux() {
@@ -87,7 +87,7 @@ config_linux() {
 
 	LDFLAGS="$LDFLAGS -ldl"
 	CXXFLAGS="$CXXFLAGS $($LLVM_CONFIG --cxxflags --ldflags)"
-	LDFLAGS="$LDFLAGS $($LLVM_CONFIG --libs core native --system-libs)"
+	LDFLAGS="$LDFLAGS $($LLVM_CONFIG --libs core native linker bitreader bitwriter --system-libs)"
 }
 
 build_odin() {
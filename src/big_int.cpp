@@ -35,7 +35,14 @@ void MP_FREE(void *mem, size_t size) {
 #define MAX_BIG_INT_SHIFT 1024
 #endif
 
-typedef mp_int BigInt;
+// NOTE: Most integer constants fit in 64 bits, so they are stored inline in `small` and only
+// promoted to a libtommath `mp_int` when an operation overflows. A `BigInt` is canonical: `big` is
+// only ever set when the value does not fit in an `i64`, and a `big` value is never mutated once
+// created, which means copies of a `BigInt` may freely share it.
+struct BigInt {
+	i64     small;
+	mp_int *big;
+};
 
 void big_int_from_u64(BigInt *dst, u64 x);
 void big_int_from_i64(BigInt *dst, i64 x);
@@ -43,7 +50,9 @@ void big_int_init    (BigInt *dst, BigInt const *src);
 void big_int_from_string(BigInt *dst, String const &s, bool *success);
 
 void big_int_dealloc(BigInt *dst) {
-	mp_clear(dst);
+	// NOTE: `big` may be shared with other copies and `MP_FREE` does nothing anyway
+	dst->small = 0;
+	dst->big = nullptr;
 }
 
 BigInt big_int_make(BigInt const *b, bool abs=false);
@@ -71,7 +80,8 @@ void big_int_and    (BigInt *dst, BigInt const *x, BigInt const *y);
 void big_int_and_not(BigInt *dst, BigInt const *x, BigInt const *y);
 void big_int_xor    (BigInt *dst, BigInt const *x, BigInt const *y);
 void big_int_or     (BigInt *dst, BigInt const *x, BigInt const *y);
-void big_int_not    (BigInt *dst, BigInt const *x, u64 bit_count, bool is_signed);
+void big_int_not    (BigInt *dst, BigInt const *x, i32 bit_count, bool is_signed);
+void big_int_abs    (BigInt *dst, BigInt const *x);
 
 
 void big_int_add_eq(BigInt *dst, BigInt const *x);
@@ -123,33 +133,101 @@ void big_int_rem_eq(BigInt *dst, BigInt const *x) {
 }
 
 
+// NOTE: A read-only `mp_int` view of a small value which uses stack storage for its digits
+struct BigIntMp {
+	mp_int   m;
+	mp_digit digits[(64 + MP_DIGIT_BIT - 1) / MP_DIGIT_BIT];
+};
+
+u64 big_int__small_magnitude(i64 x) {
+	return x < 0 ? 0ull - cast(u64)x : cast(u64)x;
+}
+
+mp_int const *big_int__mp(BigInt const *x, BigIntMp *tmp) {
+	if (x->big != nullptr) {
+		return x->big;
+	}
+	u64 mag = big_int__small_magnitude(x->small);
+	tmp->m.dp    = tmp->digits;
+	tmp->m.alloc = cast(int)gb_count_of(tmp->digits);
+	tmp->m.used  = 0;
+	tmp->m.sign  = x->small < 0 ? MP_NEG : MP_ZPOS;
+	while (mag != 0) {
+		tmp->digits[tmp->m.used++] = cast(mp_digit)(mag & MP_MASK);
+		mag >>= MP_DIGIT_BIT;
+	}
+	return &tmp->m;
+}
+
+// NOTE: Takes ownership of `r`, demoting it back to an inline value when it fits
+void big_int__set_mp(BigInt *dst, mp_int *r) {
+	if (mp_count_bits(r) <= 64) {
+		u64 mag = mp_get_mag_u64(r);
+		if (mp_isneg(r)) {
+			if (mag <= (1ull<<63)) {
+				dst->small = cast(i64)(0ull - mag);
+				dst->big = nullptr;
+				return;
+			}
+		} else if (mag < (1ull<<63)) {
+			dst->small = cast(i64)mag;
+			dst->big = nullptr;
+			return;
+		}
+	}
+	mp_int *big = gb_alloc_item(permanent_allocator(), mp_int);
+	*big = *r;
+	dst->small = 0;
+	dst->big = big;
+}
+
+typedef mp_err BigIntMpBinaryProc(mp_int const *a, mp_int const *b, mp_int *c);
+
+void big_int__mp_binary(BigInt *dst, BigInt const *x, BigInt const *y, BigIntMpBinaryProc *proc) {
+	BigIntMp tx = {};
+	BigIntMp ty = {};
+	mp_int r = {};
+	proc(big_int__mp(x, &tx), big_int__mp(y, &ty), &r);
+	big_int__set_mp(dst, &r);
+}
+
 
 i64 big_int_sign(BigInt const *x) {
-	if (mp_iszero(x)) {
+	if (x->big != nullptr) {
+		return x->big->sign == MP_ZPOS ? +1 : -1;
+	}
+	if (x->small == 0) {
 		return 0;
 	}
-	return x->sign == MP_ZPOS ? +1 : -1;
+	return x->small > 0 ? +1 : -1;
 }
 
 
 void big_int_from_u64(BigInt *dst, u64 x) {
-	mp_init_u64(dst, x);
+	if (x < (1ull<<63)) {
+		dst->small = cast(i64)x;
+		dst->big = nullptr;
+		return;
+	}
+	mp_int r = {};
+	mp_init_u64(&r, x);
+	big_int__set_mp(dst, &r);
 }
 void big_int_from_i64(BigInt *dst, i64 x) {
-	mp_init_i64(dst, x);
-
+	dst->small = x;
+	dst->big = nullptr;
 }
 void big_int_init(BigInt *dst, BigInt const *src) {
 	if (dst == src) {
 		return;
 	}
-	mp_init_copy(dst, src);
+	*dst = *src;
 }
 
 BigInt big_int_make(BigInt const *b, bool abs) {
 	BigInt i = {};
 	big_int_init(&i, b);
-	if (abs) mp_abs(&i, &i);
+	if (abs) big_int_abs(&i, &i);
 	return i;
 }
 BigInt big_int_make_abs(BigInt const *b) {
@@ -196,7 +274,7 @@ void big_int_from_string(BigInt *dst, String const &s, bool *success) {
 
 	BigInt b = {};
 	big_int_from_u64(&b, base);
-	mp_zero(dst);
+	big_int_from_i64(dst, 0);
 
 	isize i = 0;
 	for (; i < len; i++) {
@@ -263,74 +341,194 @@ void big_int_from_string(BigInt *dst, String const &s, bool *success) {
 
 
 u64 big_int_to_u64(BigInt const *x) {
-	GB_ASSERT(x->sign == 0);
-	return mp_get_u64(x);
+	GB_ASSERT(!big_int_is_neg(x));
+	if (x->big == nullptr) {
+		return cast(u64)x->small;
+	}
+	return mp_get_u64(x->big);
 }
 
 i64 big_int_to_i64(BigInt const *x) {
-	return mp_get_i64(x);
+	if (x->big == nullptr) {
+		return x->small;
+	}
+	return mp_get_i64(x->big);
 }
 
 f64 big_int_to_f64(BigInt const *x) {
-	return mp_get_double(x);
+	// NOTE: `mp_get_double` may round differently to a direct conversion above 2^53
+	if (x->big == nullptr && big_int__small_magnitude(x->small) <= (1ull<<53)) {
+		return cast(f64)x->small;
+	}
+	BigIntMp tx = {};
+	return mp_get_double(big_int__mp(x, &tx));
+}
+
+// NOTE: The number of bytes needed to store the magnitude of `x`
+isize big_int_magnitude_byte_count(BigInt const *x) {
+	if (x->big != nullptr) {
+		return cast(isize)mp_pack_count(x->big, 0, 1);
+	}
+	u64 mag = big_int__small_magnitude(x->small);
+	isize count = 0;
+	for (; mag != 0; mag >>= 8) {
+		count += 1;
+	}
+	return count;
+}
+
+// NOTE: Writes the magnitude of `x` as little-endian bytes into `dst`, zero-padding up to `len`
+void big_int_pack_magnitude(BigInt const *x, u8 *dst, isize len) {
+	GB_ASSERT(len >= big_int_magnitude_byte_count(x));
+	if (x->big != nullptr) {
+		size_t written = 0;
+		mp_err err = mp_pack(dst, cast(size_t)len, &written,
+		                     MP_LSB_FIRST,
+		                     1, MP_LITTLE_ENDIAN, 0,
+		                     x->big);
+		GB_ASSERT(err == MP_OKAY);
+		return;
+	}
+	u64 mag = big_int__small_magnitude(x->small);
+	for (isize i = 0; i < len; i++) {
+		dst[i] = cast(u8)mag;
+		mag >>= 8;
+	}
+}
+
+// NOTE: Whether the magnitude of `x` fits within a single libtommath digit, which is
+// the limit the checker has always used for array counts, #align, and constant indices
+bool big_int_is_single_digit(BigInt const *x) {
+	if (x->big != nullptr) {
+		return x->big->used <= 1;
+	}
+	return big_int__small_magnitude(x->small) <= MP_MASK;
 }
 
 
 void big_int_neg(BigInt *dst, BigInt const *x) {
-	mp_neg(x, dst);
+	if (x->big == nullptr && x->small != I64_MIN) {
+		dst->small = -x->small;
+		dst->big = nullptr;
+		return;
+	}
+	BigIntMp tx = {};
+	mp_int r = {};
+	mp_neg(big_int__mp(x, &tx), &r);
+	big_int__set_mp(dst, &r);
+}
+
+void big_int_abs(BigInt *dst, BigInt const *x) {
+	if (big_int_is_neg(x)) {
+		big_int_neg(dst, x);
+	} else {
+		big_int_init(dst, x);
+	}
 }
 
 
 int big_int_cmp(BigInt const *x, BigInt const *y) {
-	return mp_cmp(x, y);
+	if (x->big == nullptr && y->big == nullptr) {
+		if (x->small < y->small) {
+			return -1;
+		}
+		return x->small > y->small ? +1 : 0;
+	}
+	BigIntMp tx = {};
+	BigIntMp ty = {};
+	return mp_cmp(big_int__mp(x, &tx), big_int__mp(y, &ty));
 }
 
 int big_int_cmp_zero(BigInt const *x) {
-	if (mp_iszero(x)) {
-		return 0;
-	}
-	return x->sign ? -1 : +1;
+	return cast(int)big_int_sign(x);
 }
 
 bool big_int_is_zero(BigInt const *x) {
-	return mp_iszero(x);
+	return x->big == nullptr && x->small == 0;
 }
 
 
 
 
 void big_int_add(BigInt *dst, BigInt const *x, BigInt const *y) {
-	mp_add(x, y, dst);
+	if (x->big == nullptr && y->big == nullptr) {
+		i64 r = cast(i64)(cast(u64)x->small + cast(u64)y->small);
+		if (((x->small ^ r) & (y->small ^ r)) >= 0) {
+			big_int_from_i64(dst, r);
+			return;
+		}
+	}
+	big_int__mp_binary(dst, x, y, mp_add);
 }
 
 
 void big_int_sub(BigInt *dst, BigInt const *x, BigInt const *y) {
-	mp_sub(x, y, dst);
+	if (x->big == nullptr && y->big == nullptr) {
+		i64 r = cast(i64)(cast(u64)x->small - cast(u64)y->small);
+		if (((x->small ^ y->small) & (x->small ^ r)) >= 0) {
+			big_int_from_i64(dst, r);
+			return;
+		}
+	}
+	big_int__mp_binary(dst, x, y, mp_sub);
 }
 
 
 void big_int_shl(BigInt *dst, BigInt const *x, BigInt const *y) {
-	u32 yy = mp_get_u32(y);
-	mp_mul_2d(x, yy, dst);
+	u32 yy = cast(u32)big_int_to_i64(y);
+	if (x->big == nullptr && yy < 64) {
+		i64 r = cast(i64)(cast(u64)x->small << yy);
+		if ((r >> yy) == x->small) {
+			big_int_from_i64(dst, r);
+			return;
+		}
+	}
+	BigIntMp tx = {};
+	mp_int r = {};
+	mp_mul_2d(big_int__mp(x, &tx), yy, &r);
+	big_int__set_mp(dst, &r);
 }
 
 void big_int_shr(BigInt *dst, BigInt const *x, BigInt const *y) {
-	u32 yy = mp_get_u32(y);
-	BigInt d = {};
-	mp_div_2d(x, yy, dst, &d);
-	big_int_dealloc(&d);
+	u32 yy = cast(u32)big_int_to_i64(y);
+	if (x->big == nullptr) {
+		// NOTE: This shifts the magnitude, i.e. it truncates towards zero like `mp_div_2d`
+		u64 mag = big_int__small_magnitude(x->small);
+		mag = yy < 64 ? mag >> yy : 0;
+		big_int_from_i64(dst, x->small < 0 ? cast(i64)(0ull - mag) : cast(i64)mag);
+		return;
+	}
+	mp_int r = {};
+	mp_div_2d(x->big, yy, &r, nullptr);
+	big_int__set_mp(dst, &r);
 }
 
 void big_int_mul_u64(BigInt *dst, BigInt const *x, u64 y) {
 	BigInt d = {};
 	big_int_from_u64(&d, y);
-	mp_mul(x, &d, dst);
-	big_int_dealloc(&d);
+	big_int_mul(dst, x, &d);
 }
 
 
 void big_int_mul(BigInt *dst, BigInt const *x, BigInt const *y) {
-	mp_mul(x, y, dst);
+	if (x->big == nullptr && y->big == nullptr) {
+		i64 r = 0;
+	#if defined(GB_COMPILER_MSVC)
+		i64 const limit = cast(i64)1<<31;
+		bool ok = -limit < x->small && x->small < limit &&
+		          -limit < y->small && y->small < limit;
+		if (ok) {
+			r = x->small * y->small;
+		}
+	#else
+		bool ok = !__builtin_mul_overflow(x->small, y->small, &r);
+	#endif
+		if (ok) {
+			big_int_from_i64(dst, r);
+			return;
+		}
+	}
+	big_int__mp_binary(dst, x, y, mp_mul);
 }
 
 
@@ -368,29 +566,38 @@ u64 leading_zeros_u64(u64 x) {
 // q = x/y with the result truncated to zero
 // r = x - y*q
 void big_int_quo_rem(BigInt const *x, BigInt const *y, BigInt *q_, BigInt *r_) {
-	mp_div(x, y, q_, r_);
+	if (x->big == nullptr && y->big == nullptr && y->small != 0 &&
+	    !(x->small == I64_MIN && y->small == -1)) {
+		i64 q = x->small / y->small;
+		i64 r = x->small % y->small;
+		if (q_) big_int_from_i64(q_, q);
+		if (r_) big_int_from_i64(r_, r);
+		return;
+	}
+	BigIntMp tx = {};
+	BigIntMp ty = {};
+	mp_int q = {};
+	mp_int r = {};
+	mp_div(big_int__mp(x, &tx), big_int__mp(y, &ty), &q, &r);
+	if (q_) big_int__set_mp(q_, &q);
+	if (r_) big_int__set_mp(r_, &r);
 }
 
 void big_int_quo(BigInt *z, BigInt const *x, BigInt const *y) {
-	BigInt r = {};
-	big_int_quo_rem(x, y, z, &r);
-	big_int_dealloc(&r);
+	big_int_quo_rem(x, y, z, nullptr);
 }
 
 void big_int_rem(BigInt *z, BigInt const *x, BigInt const *y) {
-	BigInt q = {};
-	big_int_quo_rem(x, y, &q, z);
-	big_int_dealloc(&q);
+	big_int_quo_rem(x, y, nullptr, z);
 }
 
 void big_int_euclidean_mod(BigInt *z, BigInt const *x, BigInt const *y) {
 	BigInt y0 = {};
 	big_int_init(&y0, y);
 
-	BigInt q = {};
-	big_int_quo_rem(x, y, &q, z);
-	if (z->sign) {
-		if (y0.sign) {
+	big_int_quo_rem(x, y, nullptr, z);
+	if (big_int_is_neg(z)) {
+		if (big_int_is_neg(&y0)) {
 			big_int_sub(z, z, &y0);
 		} else {
 			big_int_add(z, z, &y0);
@@ -400,83 +607,48 @@ void big_int_euclidean_mod(BigInt *z, BigInt const *x, BigInt const *y) {
 
 
 
+// NOTE: The bitwise operations use two's complement semantics, the same as libtommath's
 void big_int_and(BigInt *dst, BigInt const *x, BigInt const *y) {
-	mp_and(x, y, dst);
-}
-
-void big_int_and_not(BigInt *dst, BigInt const *x, BigInt const *y) {
-	if (mp_iszero(x)) {
-		big_int_init(dst, y);
-		return;
-	}
-	if (mp_iszero(y)) {
-		big_int_init(dst, x);
-		return;
-	}
-
-	if (x->sign == y->sign) {
-		if (x->sign) {
-			// (-x) &~ (-y) == ~(x-1) &~ ~(y-1) == ~(x-1) & (y-1) == (y-1) &~ (x-1)
-			BigInt x1 = big_int_make_abs(x);
-			BigInt y1 = big_int_make_abs(y);
-			mp_decr(&x1);
-			mp_decr(&y1);
-
-			BigInt ny1 = {};
-			mp_complement(&y1, &ny1);
-			mp_and(&x1, &ny1, dst);
-
-			big_int_dealloc(&x1);
-			big_int_dealloc(&y1);
-			big_int_dealloc(&ny1);
-			return;
-		}
-
-		BigInt ny = {};
-		mp_complement(y, &ny);
-		mp_and(x, &ny, dst);
-
-		big_int_dealloc(&ny);
+	if (x->big == nullptr && y->big == nullptr) {
+		big_int_from_i64(dst, x->small & y->small);
 		return;
 	}
+	big_int__mp_binary(dst, x, y, mp_and);
+}
 
-	if (x->sign) {
-		// (-x) &~ y == ~(x-1) &~ y == ~(x-1) & ~y == ~((x-1) | y) == -(((x-1) | y) + 1)
-		BigInt x1 = big_int_make_abs(x);
-		BigInt y1 = big_int_make_abs(y);
-		mp_decr(&x1);
-
-		BigInt z1 = {};
-		big_int_or(&z1, &x1, &y1);
-		mp_add_d(&z1, 1, dst);
-
-		big_int_dealloc(&x1);
-		big_int_dealloc(&y1);
-		big_int_dealloc(&z1);
+void big_int_and_not(BigInt *dst, BigInt const *x, BigInt const *y) {
+	if (x->big == nullptr && y->big == nullptr) {
+		big_int_from_i64(dst, x->small & ~y->small);
 		return;
 	}
-
-	// x &~ (-y) == x &~ ~(y-1) == x & (y-1)
-	BigInt x1 = big_int_make_abs(x);
-	BigInt y1 = big_int_make_abs(y);
-	mp_decr(&y1);
-	big_int_and(dst, &x1, &y1);
-
-	big_int_dealloc(&x1);
-	big_int_dealloc(&y1);
-	return;
+	BigIntMp tx = {};
+	BigIntMp ty = {};
+	mp_int ny = {};
+	mp_int r = {};
+	mp_complement(big_int__mp(y, &ty), &ny);
+	mp_and(big_int__mp(x, &tx), &ny, &r);
+	big_int__set_mp(dst, &r);
 }
 
 void big_int_xor(BigInt *dst, BigInt const *x, BigInt const *y) {
-	mp_xor(x, y, dst);
+	if (x->big == nullptr && y->big == nullptr) {
+		big_int_from_i64(dst, x->small ^ y->small);
+		return;
+	}
+	big_int__mp_binary(dst, x, y, mp_xor);
 }
 
 
 void big_int_or(BigInt *dst, BigInt const *x, BigInt const *y) {
-	mp_or(x, y, dst);
+	if (x->big == nullptr && y->big == nullptr) {
+		big_int_from_i64(dst, x->small | y->small);
+		return;
+	}
+	big_int__mp_binary(dst, x, y, mp_or);
 }
 
 void debug_print_big_int(BigInt const *x) {
+	TEMPORARY_ALLOCATOR_GUARD();
 	String s = big_int_to_string(temporary_allocator(), x, 10);
 	gb_printf_err("[DEBUG] %.*s\n", LIT(s));
 }
@@ -488,53 +660,71 @@ void big_int_not(BigInt *dst, BigInt const *x, i32 bit_count, bool is_signed) {
 		big_int_from_u64(dst, 0);
 		return;
 	}
-	if (big_int_is_neg(x)) {
-		// ~x == -x - 1
-		big_int_neg(dst, x);
-		mp_decr(dst);
-		mp_mod_2d(dst, bit_count, dst);
+	if (x->big == nullptr && (bit_count <= 64 || x->small < 0)) {
+		u64 mask = bit_count < 64 ? (1ull<<bit_count) - 1 : ~0ull;
+		if (x->small < 0) {
+			// ~x == -x - 1
+			big_int_from_u64(dst, ~cast(u64)x->small & mask);
+			return;
+		}
+		u64 v = ~cast(u64)x->small & mask;
+		if (is_signed) {
+			// NOTE: sign extend from `bit_count` bits
+			u64 sign = 1ull<<(bit_count-1);
+			big_int_from_i64(dst, cast(i64)((v ^ sign) - sign));
+			return;
+		}
+		big_int_from_u64(dst, v);
 		return;
 	}
 
+	BigIntMp tx = {};
+	mp_int const *mx = big_int__mp(x, &tx);
 
-	BigInt pow2b = {};
-	mp_2expt(&pow2b, bit_count);
+	if (mp_isneg(mx)) {
+		// ~x == -x - 1
+		mp_int r = {};
+		mp_neg(mx, &r);
+		mp_decr(&r);
+		mp_mod_2d(&r, bit_count, &r);
+		big_int__set_mp(dst, &r);
+		return;
+	}
 
-	BigInt mask = {};
+	mp_int mask = {};
 	mp_2expt(&mask, bit_count);
 	mp_decr(&mask);
 
-	BigInt v = {};
-	mp_init_copy(&v, x);
-	mp_mod_2d(&v, bit_count, &v);
+	mp_int v = {};
+	mp_mod_2d(mx, bit_count, &v);
 
-	mp_xor(&v, &mask, dst);
+	mp_int r = {};
+	mp_xor(&v, &mask, &r);
 
 	if (is_signed) {
-		BigInt pmask = {};
-		BigInt pmask_minus_one = {};
+		mp_int pmask = {};
+		mp_int pmask_minus_one = {};
 		mp_2expt(&pmask, bit_count-1);
 		mp_sub_d(&pmask, 1, &pmask_minus_one);
 
-		BigInt a = {};
-		BigInt b = {};
-		big_int_and(&a, dst, &pmask_minus_one);
-		big_int_and(&b, dst, &pmask);
-		big_int_sub(dst, &a, &b);
-		big_int_dealloc(&a);
-		big_int_dealloc(&b);
+		mp_int a = {};
+		mp_int b = {};
+		mp_and(&r, &pmask_minus_one, &a);
+		mp_and(&r, &pmask, &b);
+		mp_sub(&a, &b, &r);
 	}
 
-	big_int_dealloc(&pow2b);
-	big_int_dealloc(&mask);
-	big_int_dealloc(&v);
+	big_int__set_mp(dst, &r);
 }
 
 bool big_int_is_neg(BigInt const *x) {
 	if (x == nullptr) {
 		return false;
 	}
-	return x->sign != MP_ZPOS;
+	if (x->big != nullptr) {
+		return x->big->sign != MP_ZPOS;
+	}
+	return x->small < 0;
 }
 
 
@@ -551,7 +741,7 @@ char digit_to_char(u8 digit) {
 String big_int_to_string(gbAllocator allocator, BigInt const *x, u64 base) {
 	GB_ASSERT(base <= 16);
 
-	if (mp_iszero(x)) {
+	if (big_int_is_zero(x)) {
 		u8 *buf = gb_alloc_array(allocator, u8, 1);
 		buf[0] = '0';
 		return make_string(buf, 1);
@@ -560,34 +750,37 @@ String big_int_to_string(gbAllocator allocator, BigInt const *x, u64 base) {
 	Array<char> buf = {};
 	array_init(&buf, allocator, 0, 32);
 
-	BigInt v = {};
-	mp_init_copy(&v, x);
-
-	if (v.sign) {
+	if (big_int_is_neg(x)) {
 		array_add(&buf, '-');
-		mp_abs(&v, &v);
 	}
 
 	isize first_word_idx = buf.count;
 
-	BigInt r = {};
-	BigInt b = {};
-	big_int_from_u64(&b, base);
+	if (x->big == nullptr) {
+		u64 v = big_int__small_magnitude(x->small);
+		do {
+			array_add(&buf, digit_to_char(cast(u8)(v % base)));
+			v /= base;
+		} while (v != 0);
+	} else {
+		BigInt v = big_int_make_abs(x);
+
+		BigInt r = {};
+		BigInt b = {};
+		big_int_from_u64(&b, base);
 
-	u8 digit = 0;
-	while (big_int_cmp(&v, &b) >= 0) {
-		big_int_quo_rem(&v, &b, &v, &r);
+		u8 digit = 0;
+		while (big_int_cmp(&v, &b) >= 0) {
+			big_int_quo_rem(&v, &b, &v, &r);
+			digit = cast(u8)big_int_to_u64(&r);
+			array_add(&buf, digit_to_char(digit));
+		}
+
+		big_int_rem(&r, &v, &b);
 		digit = cast(u8)big_int_to_u64(&r);
 		array_add(&buf, digit_to_char(digit));
 	}
 
-	big_int_rem(&r, &v, &b);
-	digit = cast(u8)big_int_to_u64(&r);
-	array_add(&buf, digit_to_char(digit));
-
-	big_int_dealloc(&r);
-	big_int_dealloc(&b);
-
 	for (isize i = first_word_idx; i < buf.count/2; i++) {
 		isize j = buf.count + first_word_idx - i - 1;
 		char tmp = buf[i];
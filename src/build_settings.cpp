@@ -295,11 +295,14 @@ struct BuildContext {
 	bool   linker_map_file;
 
 	bool use_separate_modules;
+	isize codegen_units; // maximum number of modules a package is split into with `use_separate_modules`
+	bool lto;            // link the separate modules together before the module passes
 	bool threaded_checker;
 
 	bool show_debug_messages;
 	
 	bool copy_file_contents;
+	bool memory_map_source_files;
 
 	bool disallow_rtti;
 
@@ -1010,6 +1013,9 @@ void init_build_context(TargetMetrics *cross_target) {
 	if (bc->thread_count == 0) {
 		bc->thread_count = gb_max(bc->affinity.thread_count, 1);
 	}
+	if (bc->codegen_units == 0) {
+		bc->codegen_units = bc->thread_count;
+	}
 
 	bc->ODIN_VENDOR  = str_lit("odin");
 	bc->ODIN_VERSION = ODIN_VERSION;
@@ -1039,7 +1045,7 @@ void init_build_context(TargetMetrics *cross_target) {
 		}
 	}
 
-	bc->copy_file_contents = true;
+	bc->copy_file_contents = !bc->memory_map_source_files;
 
 	TargetMetrics *metrics = nullptr;
 
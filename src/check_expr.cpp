@@ -1391,7 +1391,7 @@ Entity *check_ident(CheckerContext *c, Operand *o, Ast *n, Type *named_type, Typ
 	o->expr = n;
 	String name = n->Ident.token.string;
 
-	Entity *e = scope_lookup(c->scope, name);
+	Entity *e = scope_lookup(c->scope, ident_hash_key(n));
 	if (e == nullptr) {
 		if (is_blank_ident(name)) {
 			error(n, "'_' cannot be used as a value");
@@ -1756,14 +1756,16 @@ bool check_representable_as_constant(CheckerContext *c, ExactValue in_value, Typ
 			big_int_from_i64(&bi128, 128);
 			big_int_from_i64(&bi127, 127);
 
+			BigInt one = big_int_make_u64(1);
+
 			big_int_shl_eq(&umax, &bi128);
-			mp_decr(&umax);
+			big_int_sub_eq(&umax, &one);
 
 			big_int_shl_eq(&imin, &bi127);
 			big_int_neg(&imin, &imin);
 
 			big_int_shl_eq(&imax, &bi127);
-			mp_decr(&imax);
+			big_int_sub_eq(&imax, &one);
 		}
 
 		switch (type->Basic.kind) {
@@ -1809,7 +1811,7 @@ bool check_representable_as_constant(CheckerContext *c, ExactValue in_value, Typ
 			{
 				// return 0ull <= i && i <= umax;
 				int b = big_int_cmp(&i, &umax);
-				return !i.sign && (b <= 0);
+				return !big_int_is_neg(&i) && (b <= 0);
 			}
 
 		case Basic_UntypedInteger:
@@ -2031,7 +2033,7 @@ bool check_is_not_addressable(CheckerContext *c, Operand *o) {
 			return true;
 		}
 		ast_node(ta, TypeAssertion, expr);
-		TypeAndValue tv = ta->expr->tav;
+		TypeAndValue tv = ta->expr->tav();
 		if (is_type_pointer(tv.type)) {
 			return false;
 		}
@@ -2493,7 +2495,7 @@ void check_shift(CheckerContext *c, Operand *x, Operand *y, Ast *node, Type *typ
 		TokenPos pos = ast_token(x->expr).pos;
 		if (x_is_untyped) {
 			if (x->expr != nullptr) {
-				x->expr->tav.is_lhs = true;
+				x->expr->mutable_tav().is_lhs = true;
 			}
 			x->mode = Addressing_Value;
 			if (type_hint && is_type_integer(type_hint)) {
@@ -3399,9 +3401,9 @@ Operand make_operand_from_node(Ast *node) {
 	GB_ASSERT(node != nullptr);
 	Operand x = {};
 	x.expr  = node;
-	x.mode  = node->tav.mode;
-	x.type  = node->tav.type;
-	x.value = node->tav.value;
+	x.mode  = node->tav().mode;
+	x.type  = node->tav().type;
+	x.value = node->tav().value;
 	return x;
 }
 
@@ -3411,8 +3413,8 @@ void update_untyped_expr_type(CheckerContext *c, Ast *e, Type *type, bool final)
 	ExprInfo *old = check_get_expr_info(c, e);
 	if (old == nullptr) {
 		if (type != nullptr && type != t_invalid) {
-			if (e->tav.type == nullptr || e->tav.type == t_invalid) {
-				add_type_and_value(c->info, e, e->tav.mode, type ? type : e->tav.type, e->tav.value);
+			if (e->tav().type == nullptr || e->tav().type == t_invalid) {
+				add_type_and_value(c->info, e, e->tav().mode, type ? type : e->tav().type, e->tav().value);
 				if (e->kind == Ast_TernaryIfExpr) {
 					update_untyped_expr_type(c, e->TernaryIfExpr.x, type, final);
 					update_untyped_expr_type(c, e->TernaryIfExpr.y, type, final);
@@ -3866,7 +3868,7 @@ bool check_index_value(CheckerContext *c, Type *main_type, bool open_range, Ast
 	if (operand.mode == Addressing_Constant &&
 	    (c->state_flags & StateFlag_no_bounds_check) == 0) {
 		BigInt i = exact_value_to_integer(operand.value).value_integer;
-		if (i.sign && !is_type_enum(index_type) && !is_type_multi_pointer(main_type)) {
+		if (big_int_is_neg(&i) && !is_type_enum(index_type) && !is_type_multi_pointer(main_type)) {
 			gbString expr_str = expr_to_string(operand.expr);
 			error(operand.expr, "Index '%s' cannot be a negative value", expr_str);
 			gb_string_free(expr_str);
@@ -3915,7 +3917,7 @@ bool check_index_value(CheckerContext *c, Type *main_type, bool open_range, Ast
 
 			} else { // NOTE(bill): Do array bound checking
 				i64 v = -1;
-				if (i.used <= 1) {
+				if (big_int_is_single_digit(&i)) {
 					v = big_int_to_i64(&i);
 				}
 				if (value) *value = v;
@@ -3974,7 +3976,7 @@ ExactValue get_constant_field_single(CheckerContext *c, ExactValue value, i32 in
 		}
 
 		if (cl->elems[0]->kind == Ast_FieldValue) {
-			if (is_type_struct(node->tav.type)) {
+			if (is_type_struct(node->tav().type)) {
 				for_array(i, cl->elems) {
 					Ast *elem = cl->elems[i];
 					if (elem->kind != Ast_FieldValue) {
@@ -3982,14 +3984,14 @@ ExactValue get_constant_field_single(CheckerContext *c, ExactValue value, i32 in
 					}
 					ast_node(fv, FieldValue, elem);
 					String name = fv->field->Ident.token.string;
-					Selection sub_sel = lookup_field(node->tav.type, name, false);
+					Selection sub_sel = lookup_field(node->tav().type, name, false);
 					defer (array_free(&sub_sel.index));
 					if (sub_sel.index[0] == index) {
-						value = fv->value->tav.value;
+						value = fv->value->tav().value;
 						break;
 					}
 				}
-			} else if (is_type_array(node->tav.type) || is_type_enumerated_array(node->tav.type)) {
+			} else if (is_type_array(node->tav().type) || is_type_enumerated_array(node->tav().type)) {
 				for_array(i, cl->elems) {
 					Ast *elem = cl->elems[i];
 					if (elem->kind != Ast_FieldValue) {
@@ -3998,8 +4000,8 @@ ExactValue get_constant_field_single(CheckerContext *c, ExactValue value, i32 in
 					ast_node(fv, FieldValue, elem);
 					if (is_ast_range(fv->field)) {
 						ast_node(ie, BinaryExpr, fv->field);
-						TypeAndValue lo_tav = ie->left->tav;
-						TypeAndValue hi_tav = ie->right->tav;
+						TypeAndValue lo_tav = ie->left->tav();
+						TypeAndValue hi_tav = ie->right->tav();
 						GB_ASSERT(lo_tav.mode == Addressing_Constant);
 						GB_ASSERT(hi_tav.mode == Addressing_Constant);
 
@@ -4009,39 +4011,39 @@ ExactValue get_constant_field_single(CheckerContext *c, ExactValue value, i32 in
 
 						i64 corrected_index = index;
 
-						if (is_type_enumerated_array(node->tav.type)) {
-							Type *bt = base_type(node->tav.type);
+						if (is_type_enumerated_array(node->tav().type)) {
+							Type *bt = base_type(node->tav().type);
 							GB_ASSERT(bt->kind == Type_EnumeratedArray);
 							corrected_index = index + exact_value_to_i64(*bt->EnumeratedArray.min_value);
 						}
 						if (op != Token_RangeHalf) {
 							if (lo <= corrected_index && corrected_index <= hi) {
-								TypeAndValue tav = fv->value->tav;
+								TypeAndValue tav = fv->value->tav();
 								if (success_) *success_ = true;
 								if (finish_) *finish_ = false;
 								return tav.value;
 							}
 						} else {
 							if (lo <= corrected_index && corrected_index < hi) {
-								TypeAndValue tav = fv->value->tav;
+								TypeAndValue tav = fv->value->tav();
 								if (success_) *success_ = true;
 								if (finish_) *finish_ = false;
 								return tav.value;
 							}
 						}
 					} else {
-						TypeAndValue index_tav = fv->field->tav;
+						TypeAndValue index_tav = fv->field->tav();
 						GB_ASSERT(index_tav.mode == Addressing_Constant);
 						ExactValue index_value = index_tav.value;
-						if (is_type_enumerated_array(node->tav.type)) {
-							Type *bt = base_type(node->tav.type);
+						if (is_type_enumerated_array(node->tav().type)) {
+							Type *bt = base_type(node->tav().type);
 							GB_ASSERT(bt->kind == Type_EnumeratedArray);
 							index_value = exact_value_sub(index_value, *bt->EnumeratedArray.min_value);
 						}
 
 						i64 field_index = exact_value_to_i64(index_value);
 						if (index == field_index) {
-							TypeAndValue tav = fv->value->tav;
+							TypeAndValue tav = fv->value->tav();
 							if (success_) *success_ = true;
 							if (finish_) *finish_ = false;
 							return tav.value;;
@@ -4063,7 +4065,7 @@ ExactValue get_constant_field_single(CheckerContext *c, ExactValue value, i32 in
 				return value;
 			}
 
-			TypeAndValue tav = cl->elems[index]->tav;
+			TypeAndValue tav = cl->elems[index]->tav();
 			if (tav.mode == Addressing_Constant) {
 				if (success_) *success_ = true;
 				if (finish_) *finish_ = false;
@@ -4215,8 +4217,7 @@ bool is_entity_declared_for_selector(Entity *entity, Scope *import_scope, bool *
 // NOTE(bill, 2022-02-03): see `check_const_decl` for why it exists reasoning
 Entity *check_entity_from_ident_or_selector(CheckerContext *c, Ast *node, bool ident_only) {
 	if (node->kind == Ast_Ident) {
-		String name = node->Ident.token.string;
-		return scope_lookup(c->scope, name);
+		return scope_lookup(c->scope, ident_hash_key(node));
 	} else if (!ident_only) if (node->kind == Ast_SelectorExpr) {
 		ast_node(se, SelectorExpr, node);
 		if (se->token.kind == Token_ArrowRight) {
@@ -4251,10 +4252,9 @@ Entity *check_entity_from_ident_or_selector(CheckerContext *c, Ast *node, bool i
 				// If you can clean this up, please do but be really careful
 				String import_name = op_name;
 				Scope *import_scope = e->ImportName.scope;
-				String entity_name = selector->Ident.token.string;
 
 				check_op_expr = false;
-				entity = scope_lookup_current(import_scope, entity_name);
+				entity = scope_lookup_current(import_scope, ident_hash_key(selector));
 				bool allow_builtin = false;
 				if (!is_entity_declared_for_selector(entity, import_scope, &allow_builtin)) {
 					return nullptr;
@@ -4340,7 +4340,7 @@ Entity *check_selector(CheckerContext *c, Operand *operand, Ast *node, Type *typ
 			String entity_name = selector->Ident.token.string;
 
 			check_op_expr = false;
-			entity = scope_lookup_current(import_scope, entity_name);
+			entity = scope_lookup_current(import_scope, ident_hash_key(selector));
 			bool allow_builtin = false;
 			if (!is_entity_declared_for_selector(entity, import_scope, &allow_builtin)) {
 				error(op_expr, "'%.*s' is not declared by '%.*s'", LIT(entity_name), LIT(import_name));
@@ -4928,7 +4928,7 @@ bool check_unpack_arguments(CheckerContext *ctx, Entity **lhs, isize lhs_count,
 
 bool is_expr_constant_zero(Ast *expr) {
 	GB_ASSERT(expr != nullptr);
-	auto v = exact_value_to_integer(expr->tav.value);
+	auto v = exact_value_to_integer(expr->tav().value);
 	if (v.kind == ExactValue_Integer) {
 		return big_int_cmp_zero(&v.value_integer) == 0;
 	}
@@ -8439,7 +8439,7 @@ ExprKind check_compound_literal(CheckerContext *c, Operand *o, Ast *node, Type *
 				Ast *e = cl->elems[i];
 				GB_ASSERT(e->kind != Ast_FieldValue);
 
-				TypeAndValue tav = e->tav;
+				TypeAndValue tav = e->tav();
 				if (tav.mode != Addressing_Constant) {
 					continue;
 				}
@@ -8639,9 +8639,9 @@ ExprKind check_selector_call_expr(CheckerContext *c, Operand *o, Ast *node, Type
 	if (se->modified_call) {
 		// Prevent double evaluation
 		o->expr  = node;
-		o->type  = node->tav.type;
-		o->value = node->tav.value;
-		o->mode  = node->tav.mode;
+		o->type  = node->tav().type;
+		o->value = node->tav().value;
+		o->mode  = node->tav().mode;
 		return Expr_Expr;
 	}
 
@@ -8700,9 +8700,9 @@ ExprKind check_selector_call_expr(CheckerContext *c, Operand *o, Ast *node, Type
 	}
 
 	Operand y = {};
-	y.mode = first_arg->tav.mode;
-	y.type = first_arg->tav.type;
-	y.value = first_arg->tav.value;
+	y.mode = first_arg->tav().mode;
+	y.type = first_arg->tav().type;
+	y.value = first_arg->tav().value;
 
 	if (check_is_assignable_to(c, &y, first_type)) {
 		// Do nothing, it's valid
@@ -9145,7 +9145,7 @@ ExprKind check_expr_base_internal(CheckerContext *c, Operand *o, Ast *node, Type
 
 	case_ast_node(bl, BasicLit, node);
 		Type *t = t_invalid;
-		switch (node->tav.value.kind) {
+		switch (node->tav().value.kind) {
 		case ExactValue_String:     t = t_untyped_string;     break;
 		case ExactValue_Float:      t = t_untyped_float;      break;
 		case ExactValue_Complex:    t = t_untyped_complex;    break;
@@ -9163,7 +9163,7 @@ ExprKind check_expr_base_internal(CheckerContext *c, Operand *o, Ast *node, Type
 
 		o->mode  = Addressing_Constant;
 		o->type  = t;
-		o->value = node->tav.value;
+		o->value = node->tav().value;
 	case_end;
 
 	case_ast_node(bd, BasicDirective, node);
@@ -9615,12 +9615,12 @@ bool is_exact_value_zero(ExactValue const &v) {
 			} else {
 				for_array(i, cl->elems) {
 					Ast *elem = cl->elems[i];
-					if (elem->tav.mode != Addressing_Constant) {
-						// if (elem->tav.value.kind != ExactValue_Invalid) {
+					if (elem->tav().mode != Addressing_Constant) {
+						// if (elem->tav().value.kind != ExactValue_Invalid) {
 						return false;
 						// }
 					}
-					if (!is_exact_value_zero(elem->tav.value)) {
+					if (!is_exact_value_zero(elem->tav().value)) {
 						return false;
 					}
 				}
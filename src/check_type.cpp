@@ -234,7 +234,7 @@ bool check_custom_align(CheckerContext *ctx, Ast *node, i64 *align_) {
 	if (is_type_untyped(type) || is_type_integer(type)) {
 		if (o.value.kind == ExactValue_Integer) {
 			BigInt v = o.value.value_integer;
-			if (v.used > 1) {
+			if (!big_int_is_single_digit(&v)) {
 				gbAllocator a = heap_allocator();
 				String str = big_int_to_string(a, &v);
 				error(node, "#align too large, %.*s", LIT(str));
@@ -2150,9 +2150,8 @@ i64 check_array_count(CheckerContext *ctx, Operand *o, Ast *e) {
 				gb_free(a, str.text);
 				return 0;
 			}
-			switch (count.used) {
-			case 0: return 0;
-			case 1: return big_int_to_u64(&count);
+			if (big_int_is_single_digit(&count)) {
+				return big_int_to_u64(&count);
 			}
 			gbAllocator a = heap_allocator();
 			String str = big_int_to_string(a, &count);
@@ -2609,8 +2608,8 @@ bool check_type_internal(CheckerContext *ctx, Ast *e, Type **type, Type *named_t
 	case_end;
 
 	case_ast_node(tt, TypeidType, e);
-		e->tav.mode = Addressing_Type;
-		e->tav.type = t_typeid;
+		e->mutable_tav().mode = Addressing_Type;
+		e->mutable_tav().type = t_typeid;
 		*type = t_typeid;
 		set_base_type(named_type, *type);
 		return true;
@@ -2972,6 +2971,8 @@ bool check_type_internal(CheckerContext *ctx, Ast *e, Type **type, Type *named_t
 		*type = alloc_type(Type_Map);
 		set_base_type(named_type, *type);
 		check_map_type(ctx, *type, e);
+		*type = intern_type_map(*type);
+		set_base_type(named_type, *type);
 		return true;
 	case_end;
 
@@ -402,24 +402,53 @@ void check_close_scope(CheckerContext *c) {
 }
 
 
-Entity *scope_lookup_current(Scope *s, String const &name) {
-	Entity **found = string_map_get(&s->elements, name);
+StringHashKey ident_hash_key(Ast *ident) {
+	GB_ASSERT(ident->kind == Ast_Ident);
+	StringHashKey key = {};
+	key.hash = ident->Ident.hash;
+	key.string = ident->Ident.token.string;
+	return key;
+}
+
+Entity *scope_lookup_current(Scope *s, StringHashKey const &key) {
+	Entity **found = string_map_get(&s->elements, key);
 	if (found) {
 		return *found;
 	}
 	return nullptr;
 }
 
-void scope_lookup_parent(Scope *scope, String const &name, Scope **scope_, Entity **entity_) {
+Entity *scope_lookup_current(Scope *s, String const &name) {
+	return scope_lookup_current(s, string_hash_string(name));
+}
+
+// NOTE: Package, file, and builtin scopes are frozen once all of the entities have been collected
+// and imported, so they can be read without locking. Any other scope may still be inserted into.
+gb_inline bool scope_lookup_is_lock_free(Scope *s) {
+	return (s->flags & ScopeFlag_Frozen) != 0;
+}
+
+void freeze_scope(Scope *s) {
+	if (s != nullptr) {
+		mutex_lock(&s->mutex);
+		s->flags |= ScopeFlag_Frozen;
+		mutex_unlock(&s->mutex);
+	}
+}
+
+void scope_lookup_parent(Scope *scope, StringHashKey const &key, Scope **scope_, Entity **entity_) {
 	if (scope != nullptr) {
 		bool gone_thru_proc = false;
 		bool gone_thru_package = false;
-		StringHashKey key = string_hash_string(name);
 		for (Scope *s = scope; s != nullptr; s = s->parent) {
 			Entity **found = nullptr;
-			mutex_lock(&s->mutex);
-			found = string_map_get(&s->elements, key);
-			mutex_unlock(&s->mutex);
+			if (scope_lookup_is_lock_free(s)) {
+				found = string_map_get(&s->elements, key);
+			} else {
+				mutex_lock(&s->mutex);
+				found = string_map_get(&s->elements, key);
+				mutex_unlock(&s->mutex);
+			}
 			if (found) {
 				Entity *e = *found;
 				if (gone_thru_proc) {
@@ -455,12 +484,20 @@ void scope_lookup_parent(Scope *scope, String const &name, Scope **scope_, Entit
 	if (scope_) *scope_ = nullptr;
 }
 
-Entity *scope_lookup(Scope *s, String const &name) {
+void scope_lookup_parent(Scope *scope, String const &name, Scope **scope_, Entity **entity_) {
+	scope_lookup_parent(scope, string_hash_string(name), scope_, entity_);
+}
+
+Entity *scope_lookup(Scope *s, StringHashKey const &key) {
 	Entity *entity = nullptr;
-	scope_lookup_parent(s, name, nullptr, &entity);
+	scope_lookup_parent(s, key, nullptr, &entity);
 	return entity;
 }
 
+Entity *scope_lookup(Scope *s, String const &name) {
+	return scope_lookup(s, string_hash_string(name));
+}
+
 
 
 Entity *scope_insert_with_name(Scope *s, String const &name, Entity *entity, bool use_mutex=true) {
@@ -471,6 +508,8 @@ Entity *scope_insert_with_name(Scope *s, String const &name, Entity *entity, boo
 	Entity **found = nullptr;
 	Entity *result = nullptr;
 
+	GB_ASSERT_MSG((s->flags & ScopeFlag_Frozen) == 0, "Inserting '%.*s' into a frozen scope", LIT(name));
+
 	if (use_mutex) mutex_lock(&s->mutex);
 	defer (if (use_mutex) mutex_unlock(&s->mutex));
 	
@@ -1129,6 +1168,7 @@ void init_checker_info(CheckerInfo *i) {
 	map_init(&i->gen_types,       a);
 	array_init(&i->type_info_types, a);
 	map_init(&i->type_info_map,   a);
+	map_init(&i->type_info_hash_map, a);
 	string_map_init(&i->files,    a);
 	string_map_init(&i->packages, a);
 	array_init(&i->variable_init_order, a);
@@ -1160,7 +1200,9 @@ void init_checker_info(CheckerInfo *i) {
 	mutex_init(&i->global_untyped_mutex);
 	mutex_init(&i->type_info_mutex);
 	mutex_init(&i->deps_mutex);
-	mutex_init(&i->type_and_value_mutex);
+	for (isize j = 0; j < TYPE_AND_VALUE_MUTEX_COUNT; j++) {
+		mutex_init(&i->type_and_value_mutexes[j]);
+	}
 	mutex_init(&i->identifier_uses_mutex);
 	mutex_init(&i->foreign_mutex);
 
@@ -1181,6 +1223,7 @@ void destroy_checker_info(CheckerInfo *i) {
 	map_destroy(&i->gen_types);
 	array_free(&i->type_info_types);
 	map_destroy(&i->type_info_map);
+	map_destroy(&i->type_info_hash_map);
 	string_map_destroy(&i->files);
 	string_map_destroy(&i->packages);
 	array_free(&i->variable_init_order);
@@ -1199,7 +1242,9 @@ void destroy_checker_info(CheckerInfo *i) {
 	mutex_destroy(&i->global_untyped_mutex);
 	mutex_destroy(&i->type_info_mutex);
 	mutex_destroy(&i->deps_mutex);
-	mutex_destroy(&i->type_and_value_mutex);
+	for (isize j = 0; j < TYPE_AND_VALUE_MUTEX_COUNT; j++) {
+		mutex_destroy(&i->type_and_value_mutexes[j]);
+	}
 	mutex_destroy(&i->identifier_uses_mutex);
 	mutex_destroy(&i->foreign_mutex);
 
@@ -1283,13 +1328,13 @@ void destroy_checker(Checker *c) {
 TypeAndValue type_and_value_of_expr(Ast *expr) {
 	TypeAndValue tav = {};
 	if (expr != nullptr) {
-		tav = expr->tav;
+		tav = expr->tav();
 	}
 	return tav;
 }
 
 Type *type_of_expr(Ast *expr) {
-	TypeAndValue tav = expr->tav;
+	TypeAndValue tav = expr->tav();
 	if (tav.mode != Addressing_Invalid) {
 		return tav.type;
 	}
@@ -1391,6 +1436,17 @@ void check_remove_expr_info(CheckerContext *c, Ast *e) {
 }
 
 
+// NOTE: Must be called with 'type_info_mutex' held
+isize type_info_find_structural(CheckerInfo *info, Type *type) {
+	uintptr hash = cast(uintptr)type_hash_structural_unique_tuples(type);
+	for (auto *e = multi_map_find_first(&info->type_info_hash_map, hash); e != nullptr; e = multi_map_find_next(&info->type_info_hash_map, e)) {
+		if (are_types_identical_unique_tuples(info->type_info_types[e->value], type)) {
+			return e->value;
+		}
+	}
+	return -1;
+}
+
 isize type_info_index(CheckerInfo *info, Type *type, bool error_on_failure) {
 	type = default_type(type);
 	if (type == t_llvm_bool) {
@@ -1405,16 +1461,10 @@ isize type_info_index(CheckerInfo *info, Type *type, bool error_on_failure) {
 		entry_index = *found_entry_index;
 	}
 	if (entry_index < 0) {
-		// NOTE(bill): Do manual search
-		// TODO(bill): This is O(n) and can be very slow
-		for_array(i, info->type_info_map.entries){
-			auto *e = &info->type_info_map.entries[i];
-			if (are_types_identical_unique_tuples(e->key, type)) {
-				entry_index = e->value;
-				// NOTE(bill): Add it to the search map
-				map_set(&info->type_info_map, type, entry_index);
-				break;
-			}
+		entry_index = type_info_find_structural(info, type);
+		if (entry_index >= 0) {
+			// NOTE(bill): Add it to the search map
+			map_set(&info->type_info_map, type, entry_index);
 		}
 	}
 
@@ -1455,29 +1505,42 @@ void add_type_and_value(CheckerInfo *i, Ast *expr, AddressingMode mode, Type *ty
 		return;
 	}
 
-	mutex_lock(&i->type_and_value_mutex);
 	Ast *prev_expr = nullptr;
 	while (prev_expr != expr) {
 		prev_expr = expr;
-		expr->tav.mode = mode;
-		if (type != nullptr && expr->tav.type != nullptr &&
-		    is_type_any(type) && is_type_untyped(expr->tav.type)) {
+
+		BlockingMutex *m = &i->type_and_value_mutexes[ptr_map_hash_key(expr) & (TYPE_AND_VALUE_MUTEX_COUNT-1)];
+		if (build_context.show_more_timings) {
+			i->type_and_value_lock_count.fetch_add(1, std::memory_order_relaxed);
+			if (!mutex_try_lock(m)) {
+				i->type_and_value_contended_count.fetch_add(1, std::memory_order_relaxed);
+				mutex_lock(m);
+			}
+		} else {
+			mutex_lock(m);
+		}
+
+		TypeAndValue &tav = expr->mutable_tav();
+		tav.mode = mode;
+		if (type != nullptr && tav.type != nullptr &&
+		    is_type_any(type) && is_type_untyped(tav.type)) {
 			// ignore
 		} else {
-			expr->tav.type = type;
+			tav.type = type;
 		}
 
 		if (mode == Addressing_Constant || mode == Addressing_Invalid) {
-			expr->tav.value = value;
+			tav.value = value;
 		} else if (mode == Addressing_Value && is_type_typeid(type)) {
-			expr->tav.value = value;
+			tav.value = value;
 		} else if (mode == Addressing_Value && is_type_proc(type)) {
-			expr->tav.value = value;
+			tav.value = value;
 		}
 
+		mutex_unlock(m);
+
 		expr = unparen_expr(expr);
 	}
-	mutex_unlock(&i->type_and_value_mutex);
 }
 
 void add_entity_definition(CheckerInfo *i, Ast *identifier, Entity *entity) {
@@ -1758,21 +1821,16 @@ void add_type_info_type_internal(CheckerContext *c, Type *t) {
 	}
 
 	bool prev = false;
-	isize ti_index = -1;
-	for_array(i, c->info->type_info_map.entries) {
-		auto *e = &c->info->type_info_map.entries[i];
-		if (are_types_identical_unique_tuples(t, e->key)) {
-			// Duplicate entry
-			ti_index = e->value;
-			prev = true;
-			break;
-		}
-	}
-	if (ti_index < 0) {
+	isize ti_index = type_info_find_structural(c->info, t);
+	if (ti_index >= 0) {
+		// Duplicate entry
+		prev = true;
+	} else {
 		// Unique entry
 		// NOTE(bill): map entries grow linearly and in order
 		ti_index = c->info->type_info_types.count;
 		array_add(&c->info->type_info_types, t);
+		multi_map_insert(&c->info->type_info_hash_map, cast(uintptr)type_hash_structural_unique_tuples(t), ti_index);
 	}
 	map_set(&c->checker->info.type_info_map, t, ti_index);
 
@@ -2188,9 +2246,13 @@ void add_dependency_to_set(Checker *c, Entity *entity) {
 		}
 	}
 
-	if (ptr_set_update(set, entity)) {
+	// NOTE: The flag on the entity is the membership test, the set itself is only appended to
+	// as the order of the set is the order of the depth first traversal
+	u64 prev_flags = entity->flags.fetch_or(EntityFlag_MinimumDependency, std::memory_order_relaxed);
+	if (prev_flags & EntityFlag_MinimumDependency) {
 		return;
 	}
+	ptr_set_add(set, entity);
 
 	DeclInfo *decl = decl_info_of_entity(entity);
 	if (decl == nullptr) {
@@ -2464,6 +2526,52 @@ bool is_entity_a_dependency(Entity *e) {
 	return false;
 }
 
+struct EntityGraphSuccSection {
+	PtrMap<Entity *, EntityGraphNode *> *M;
+	isize offset;
+	isize count;
+};
+
+void entity_graph_add_succ_edges(PtrMap<Entity *, EntityGraphNode *> *M, isize offset, isize count) {
+	isize end = gb_min(offset+count, M->entries.count);
+	for (isize i = offset; i < end; i++) {
+		EntityGraphNode *n = M->entries[i].value;
+		Entity *e = n->entity;
+
+		DeclInfo *decl = decl_info_of_entity(e);
+		GB_ASSERT(decl != nullptr);
+
+		for_array(j, decl->deps.entries) {
+			Entity *dep = decl->deps.entries[j].ptr;
+			if (dep->flags & EntityFlag_Field) {
+				continue;
+			}
+			GB_ASSERT(dep != nullptr);
+			if (is_entity_a_dependency(dep)) {
+				EntityGraphNode *m = map_must_get(M, dep);
+				entity_graph_node_set_add(&n->succ, m);
+			}
+		}
+	}
+}
+
+// Connects the pred 'p' of the procedure node 'n' to the succ 's' of 'n', bypassing 'n'
+gb_inline void entity_graph_connect_through(EntityGraphNode *p, EntityGraphNode *n, EntityGraphNode *s) {
+	// Ignore self-cycles
+	if (s != n) {
+		entity_graph_node_set_add(&p->succ, s);
+		entity_graph_node_set_add(&s->pred, p);
+		// Remove edge to 'n'
+		entity_graph_node_set_remove(&s->pred, n);
+	}
+}
+
+WORKER_TASK_PROC(thread_proc_entity_graph_succ_edges) {
+	auto *section = cast(EntityGraphSuccSection *)data;
+	entity_graph_add_succ_edges(section->M, section->offset, section->count);
+	return 0;
+}
+
 Array<EntityGraphNode *> generate_entity_dependency_graph(CheckerInfo *info, gbAllocator allocator) {
 	PtrMap<Entity *, EntityGraphNode *> M = {};
 	map_init(&M, allocator, info->entities.count);
@@ -2479,71 +2587,79 @@ Array<EntityGraphNode *> generate_entity_dependency_graph(CheckerInfo *info, gbA
 
 	TIME_SECTION("generate_entity_dependency_graph: Calculate edges for graph M - Part 1");
 	// Calculate edges for graph M
+	// NOTE: Each node only writes to its own succ set, so these can be calculated in parallel
+	isize thread_count = gb_max(build_context.thread_count, 1);
+	if (build_context.threaded_checker && thread_count > 1 && M.entries.count >= 1024) {
+		isize count_per_thread = (M.entries.count+thread_count-1)/thread_count;
+		EntityGraphSuccSection *sections = gb_alloc_array(temporary_allocator(), EntityGraphSuccSection, thread_count);
+		for (isize i = 0; i < thread_count; i++) {
+			sections[i].M = &M;
+			sections[i].offset = i*count_per_thread;
+			sections[i].count = count_per_thread;
+			global_thread_pool_add_task(thread_proc_entity_graph_succ_edges, sections+i);
+		}
+		global_thread_pool_wait();
+	} else {
+		entity_graph_add_succ_edges(&M, 0, M.entries.count);
+	}
+	// NOTE: The preds are added in the same order as the succs were found so that the
+	// order of each pred set (which affects the initialization order) does not depend on the threading
 	for_array(i, M.entries) {
 		EntityGraphNode *n = M.entries[i].value;
-		Entity *e = n->entity;
-
-		DeclInfo *decl = decl_info_of_entity(e);
-		GB_ASSERT(decl != nullptr);
-
-		for_array(j, decl->deps.entries) {
-			Entity *dep = decl->deps.entries[j].ptr;
-			if (dep->flags & EntityFlag_Field) {
-				continue;
-			}
-			GB_ASSERT(dep != nullptr);
-			if (is_entity_a_dependency(dep)) {
-				EntityGraphNode *m = map_must_get(&M, dep);
-				entity_graph_node_set_add(&n->succ, m);
-				entity_graph_node_set_add(&m->pred, n);
-			}
+		for_array(j, n->succ.entries) {
+			EntityGraphNode *m = n->succ.entries[j].ptr;
+			entity_graph_node_set_add(&m->pred, n);
 		}
 	}
 
-	// TODO(bill): This could be multithreaded to improve performance
-	// This means that the entity graph node set will have to be thread safe
-
 	TIME_SECTION("generate_entity_dependency_graph: Calculate edges for graph M - Part 2");
 	auto G = array_make<EntityGraphNode *>(allocator, 0, M.entries.count);
 
+	// NOTE: The succs of 'n' which are not procedures, as an edge is never added between two procedures
+	auto non_proc_succs = array_make<EntityGraphNode *>(heap_allocator(), 0, 16);
+	defer (array_free(&non_proc_succs));
+
 	for_array(i, M.entries) {
 		auto *entry = &M.entries[i];
 		auto *e = entry->key;
 		EntityGraphNode *n = entry->value;
 
 		if (e->kind == Entity_Procedure) {
+			array_clear(&non_proc_succs);
+			for_array(k, n->succ.entries) {
+				EntityGraphNode *s = n->succ.entries[k].ptr;
+				if (s->entity->kind != Entity_Procedure) {
+					array_add(&non_proc_succs, s);
+				}
+			}
+
 			// Connect each pred 'p' of 'n' with each succ 's' and from
 			// the procedure node
 			for_array(j, n->pred.entries) {
 				EntityGraphNode *p = n->pred.entries[j].ptr;
 
 				// Ignore self-cycles
-				if (p != n) {
-					// Each succ 's' of 'n' becomes a succ of 'p', and
-					// each pred 'p' of 'n' becomes a pred of 's'
+				if (p == n) {
+					continue;
+				}
+
+				// Each succ 's' of 'n' becomes a succ of 'p', and
+				// each pred 'p' of 'n' becomes a pred of 's'
+				// NOTE(bill, 2020-11-15): Only care about variable initialization ordering, so if 'p' is a
+				// procedure, only the succs which are not procedures need to be connected
+				// TODO(bill): This is probably wrong!!!!
+				if (p->entity->kind == Entity_Procedure) {
+					for_array(k, non_proc_succs) {
+						entity_graph_connect_through(p, n, non_proc_succs[k]);
+					}
+				} else {
 					for_array(k, n->succ.entries) {
-						EntityGraphNode *s = n->succ.entries[k].ptr;
-						// Ignore self-cycles
-						if (s != n) {
-							if (p->entity->kind == Entity_Procedure &&
-							    s->entity->kind == Entity_Procedure) {
-							    	// NOTE(bill, 2020-11-15): Only care about variable initialization ordering
-							    	// TODO(bill): This is probably wrong!!!!
-								continue;
-							}
-							// IMPORTANT NOTE/TODO(bill, 2020-11-15): These three calls take the majority of the
-							// the time to process
-
-							entity_graph_node_set_add(&p->succ, s);
-							entity_graph_node_set_add(&s->pred, p);
-							// Remove edge to 'n'
-							entity_graph_node_set_remove(&s->pred, n);
-						}
+						entity_graph_connect_through(p, n, n->succ.entries[k].ptr);
 					}
-
-					// Remove edge to 'n'
-					entity_graph_node_set_remove(&p->succ, n);
 				}
+
+				// Remove edge to 'n'
+				entity_graph_node_set_remove(&p->succ, n);
 			}
 		} else if (e->kind == Entity_Variable) {
 			array_add(&G, n);
@@ -3659,8 +3775,8 @@ void check_collect_value_decl(CheckerContext *c, Ast *decl) {
 				if (value != nullptr) {
 					if (value->kind == Ast_BasicLit && value->BasicLit.token.kind == Token_String) {
 						String v = {};
-						if (value->tav.value.kind == ExactValue_String) {
-							v = value->tav.value.value_string;
+						if (value->tav().value.kind == ExactValue_String) {
+							v = value->tav().value.value_string;
 						}
 						if (v == "file") {
 							kind = EntityVisiblity_PrivateToFile;
@@ -5250,7 +5366,7 @@ void check_test_procedures(Checker *c) {
 		if (e == nullptr) {
 			Token tok = {};
 			if (pkg->files.count != 0) {
-				tok = pkg->files[0]->tokens[0];
+				tok = ast_file_token(pkg->files[0], 0);
 			}
 			error(tok, "Unable to find the test '%.*s' in 'package %.*s' ", LIT(name), LIT(pkg->name));
 		}
@@ -5297,8 +5413,31 @@ struct ThreadProcBodyData {
 	u32 thread_index;
 	u32 thread_count;
 	ThreadProcBodyData *all_data;
+	std::atomic<isize> *active_count;
 };
 
+bool thread_proc_body_steal(ThreadProcBodyData *bd, ProcInfo **pi_) {
+	// NOTE: Try to take work from the other threads' queues, starting with the neighbour
+	// The victim's mutex is taken to prevent `mpmc_internal_grow` from resizing the queue
+	// underneath this thread, as only the owning thread ever enqueues onto its queue
+	for (u32 j = 1; j < bd->thread_count; j++) {
+		ThreadProcBodyData *victim = bd->all_data + (bd->thread_index+j) % bd->thread_count;
+		ProcBodyQueue *q = victim->queue;
+		if (q->count.load(std::memory_order_relaxed) <= 0) {
+			continue;
+		}
+		if (!mutex_try_lock(&q->mutex)) {
+			continue;
+		}
+		bool ok = mpmc_dequeue(q, pi_);
+		mutex_unlock(&q->mutex);
+		if (ok) {
+			return true;
+		}
+	}
+	return false;
+}
+
 WORKER_TASK_PROC(thread_proc_body) {
 	ThreadProcBodyData *bd = cast(ThreadProcBodyData *)data;
 	Checker *c = bd->checker;
@@ -5308,8 +5447,21 @@ WORKER_TASK_PROC(thread_proc_body) {
 	UntypedExprInfoMap untyped = {};
 	map_init(&untyped, heap_allocator());
 
-	for (ProcInfo *pi; mpmc_dequeue(this_queue, &pi); /**/) {
-		consume_proc_info_queue(c, pi, this_queue, &untyped);
+	for (;;) {
+		ProcInfo *pi = nullptr;
+		bd->active_count->fetch_add(1, std::memory_order_acq_rel);
+		if (mpmc_dequeue(this_queue, &pi) || thread_proc_body_steal(bd, &pi)) {
+			// NOTE: Any nested procedure bodies are pushed onto this thread's queue,
+			// which other threads may then steal from
+			consume_proc_info_queue(c, pi, this_queue, &untyped);
+			bd->active_count->fetch_sub(1, std::memory_order_acq_rel);
+			continue;
+		}
+		if (bd->active_count->fetch_sub(1, std::memory_order_acq_rel) == 1) {
+			// NOTE: No other thread is checking a body, so no more work can appear
+			break;
+		}
+		yield_thread();
 	}
 
 	map_destroy(&untyped);
@@ -5348,6 +5500,9 @@ void check_procedure_bodies(Checker *c) {
 	isize original_queue_count = c->procs_to_check_queue.count.load(std::memory_order_relaxed);
 	isize load_count = (original_queue_count+thread_count-1)/thread_count;
 
+	std::atomic<isize> *active_count = gb_alloc_item(permanent_allocator(), std::atomic<isize>);
+	active_count->store(0);
+
 	ThreadProcBodyData *thread_data = gb_alloc_array(permanent_allocator(), ThreadProcBodyData, thread_count);
 	for (u32 i = 0; i < thread_count; i++) {
 		ThreadProcBodyData *data = thread_data + i;
@@ -5356,6 +5511,7 @@ void check_procedure_bodies(Checker *c) {
 		data->thread_index = i;
 		data->thread_count = thread_count;
 		data->all_data = thread_data;
+		data->active_count = active_count;
 		// NOTE(bill) 2x the amount assumes on average only 1 nested procedure
 		// TODO(bill): Determine a good heuristic
 		mpmc_init(data->queue, heap_allocator(), next_pow2_isize(load_count*2));
@@ -5663,13 +5819,27 @@ void add_type_info_for_type_definitions(Checker *c) {
 		Entity *e = c->info.definitions[i];
 		if (e->kind == Entity_TypeName && e->type != nullptr) {
 			i64 align = type_align_of(e->type);
-			if (align > 0 && ptr_set_exists(&c->info.minimum_dependency_set, e)) {
+			if (align > 0 && is_entity_a_minimum_dependency(e)) {
 				add_type_info_type(&c->builtin_ctx, e->type);
 			}
 		}
 	}
 }
 
+void check_freeze_global_scopes(Checker *c) {
+	// NOTE: No more entities are added to package or file scopes after this point
+	freeze_scope(builtin_pkg->scope);
+	freeze_scope(intrinsics_pkg->scope);
+	freeze_scope(config_pkg->scope);
+	for_array(i, c->info.packages.entries) {
+		AstPackage *pkg = c->info.packages.entries[i].value;
+		freeze_scope(pkg->scope);
+		for_array(j, pkg->files) {
+			freeze_scope(pkg->files[j]->scope);
+		}
+	}
+}
+
 void check_parsed_files(Checker *c) {
 	TIME_SECTION("map full filepaths to scope");
 	add_type_info_type(&c->builtin_ctx, t_invalid);
@@ -5706,6 +5876,9 @@ void check_parsed_files(Checker *c) {
 	TIME_SECTION("export entities - post");
 	check_export_entities(c);
 
+	TIME_SECTION("freeze package and file scopes");
+	check_freeze_global_scopes(c);
+
 	TIME_SECTION("add entities from packages");
 	check_merge_queues_into_arrays(c);
 
@@ -5810,7 +5983,7 @@ void check_parsed_files(Checker *c) {
 			if (s->pkg->files.count > 0) {
 				AstFile *f = s->pkg->files[0];
 				if (f->tokens.count > 0) {
-					token = f->tokens[0];
+					token = ast_file_token(f, 0);
 				}
 			}
 
@@ -191,11 +191,13 @@ enum ScopeFlag : i32 {
 	ScopeFlag_Type    = 1<<7,
 
 	ScopeFlag_HasBeenImported = 1<<10, // This is only applicable to file scopes
+	ScopeFlag_Frozen          = 1<<11, // No more entities will be inserted, so lookups do not need to lock
 
 	ScopeFlag_ContextDefined = 1<<16,
 };
 
 enum { DEFAULT_SCOPE_CAPACITY = 29 };
+enum { TYPE_AND_VALUE_MUTEX_COUNT = 64 };
 
 struct Scope {
 	Ast *         node;
@@ -331,7 +333,11 @@ struct CheckerInfo {
 	// too much of a problem in practice
 	BlockingMutex deps_mutex;
 
-	BlockingMutex type_and_value_mutex;
+	// NOTE: `add_type_and_value` only needs to guard against two threads writing to the same node,
+	// so the mutex is chosen from the node's address rather than there being one for everything
+	BlockingMutex type_and_value_mutexes[TYPE_AND_VALUE_MUTEX_COUNT];
+	std::atomic<u64> type_and_value_lock_count;      // only recorded with -show-more-timings
+	std::atomic<u64> type_and_value_contended_count; // only recorded with -show-more-timings
 
 	RecursiveMutex lazy_mutex; // Mutex required for lazy type checking of specific files
 
@@ -343,6 +349,7 @@ struct CheckerInfo {
 	BlockingMutex type_info_mutex; // NOT recursive
 	Array<Type *> type_info_types;
 	PtrMap<Type *, isize> type_info_map;
+	PtrMap<uintptr, isize> type_info_hash_map; // Key: type_hash_structural_unique_tuples -> index into type_info_types (multi-map)
 
 	BlockingMutex foreign_mutex; // NOT recursive
 	StringMap<Entity *> foreigns;
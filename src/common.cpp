@@ -330,33 +330,132 @@ gb_global bool global_module_path_set = false;
 
 
 struct StringIntern {
-	StringIntern *next;
+	u64   hash;
 	isize len;
-	char str[1];
+	char  str[1];
 };
 
-PtrMap<uintptr, StringIntern *> string_intern_map = {}; // Key: u64
-gb_global Arena string_intern_arena = {};
+// NOTE: The string interner is an open addressing table of pointers to entries.
+// Lookups and inserts take no locks: a new entry is placed into an empty slot with a
+// compare-and-swap, and entries are never removed. Once a table is half full, it is
+// migrated into one twice the size; every empty slot of the old table is marked as
+// moved so that nothing more can be inserted into it, and any thread which finds such
+// a slot waits for the new table to be published and continues in that one. That wait
+// is the only time a thread can block on another.
+struct StringInternTable {
+	isize                              capacity;
+	std::atomic<isize>                 count;
+	std::atomic<bool>                  growing;
+	std::atomic<StringInternTable *>   next;
+	std::atomic<StringIntern *>        slots[1];
+};
+
+enum {STRING_INTERN_INITIAL_CAPACITY = 1<<16};
+#define STRING_INTERN_MOVED (cast(StringIntern *)cast(uintptr)1)
+
+gb_global std::atomic<StringInternTable *> string_intern_table;
+// NOTE: Each thread allocates its entries from its own arena, so an insert never takes a lock
+gb_global gb_thread_local Arena string_intern_arena = {nullptr, DEFAULT_MINIMUM_BLOCK_SIZE, true};
+
+// Reported with -show-more-timings
+gb_global std::atomic<isize> string_intern_lost_race_count;
+gb_global std::atomic<isize> string_intern_grow_count;
+gb_global std::atomic<u64>   string_intern_grow_time; // in time stamp ticks
+
+u64 time_stamp_time_now(void);
+
+StringInternTable *string_intern_table_make(isize capacity) {
+	GB_ASSERT(gb_is_power_of_two(capacity));
+	isize size = gb_offset_of(StringInternTable, slots) + capacity*gb_size_of(std::atomic<StringIntern *>);
+	StringInternTable *t = cast(StringInternTable *)gb_alloc(heap_allocator(), size);
+	t->capacity = capacity;
+	t->count.store(0, std::memory_order_relaxed);
+	t->growing.store(false, std::memory_order_relaxed);
+	t->next.store(nullptr, std::memory_order_relaxed);
+	for (isize i = 0; i < capacity; i++) {
+		t->slots[i].store(nullptr, std::memory_order_relaxed);
+	}
+	return t;
+}
+
+void string_intern_grow(StringInternTable *t) {
+	u64 start = time_stamp_time_now();
+
+	StringInternTable *n = string_intern_table_make(t->capacity*2);
+	isize mask = n->capacity-1;
+	for (isize i = 0; i < t->capacity; i++) {
+		StringIntern *e = t->slots[i].load(std::memory_order_acquire);
+		while (e == nullptr) {
+			if (t->slots[i].compare_exchange_weak(e, STRING_INTERN_MOVED, std::memory_order_acq_rel, std::memory_order_acquire)) {
+				break;
+			}
+		}
+		if (e == nullptr || e == STRING_INTERN_MOVED) {
+			continue;
+		}
+		// NOTE: Entries in the old table are unique and the new one is not yet visible to
+		// any other thread, so the entry can be stored in the first empty slot
+		isize j = cast(isize)(e->hash & cast(u64)mask);
+		while (n->slots[j].load(std::memory_order_relaxed) != nullptr) {
+			j = (j+1) & mask;
+		}
+		n->slots[j].store(e, std::memory_order_relaxed);
+		n->count.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	t->next.store(n, std::memory_order_release);
+	string_intern_table.store(n, std::memory_order_release);
+
+	string_intern_grow_count.fetch_add(1, std::memory_order_relaxed);
+	string_intern_grow_time.fetch_add(time_stamp_time_now() - start, std::memory_order_relaxed);
+}
+
+StringInternTable *string_intern_wait_for_next(StringInternTable *t) {
+	StringInternTable *n = nullptr;
+	while ((n = t->next.load(std::memory_order_acquire)) == nullptr) {
+		yield();
+	}
+	return n;
+}
 
 char const *string_intern(char const *text, isize len) {
 	u64 hash = gb_fnv64a(text, len);
-	uintptr key = cast(uintptr)(hash ? hash : 1);
-	StringIntern **found = map_get(&string_intern_map, key);
-	if (found) {
-		for (StringIntern *it = *found; it != nullptr; it = it->next) {
-			if (it->len == len && gb_strncmp(it->str, (char *)text, len) == 0) {
-				return it->str;
+	StringIntern *new_intern = nullptr;
+
+	StringInternTable *t = string_intern_table.load(std::memory_order_acquire);
+	for (;;) {
+		isize mask = t->capacity-1;
+		isize i = cast(isize)(hash & cast(u64)mask);
+		isize probes = 0;
+		for (; probes < t->capacity; probes++, i = (i+1) & mask) {
+			StringIntern *e = t->slots[i].load(std::memory_order_acquire);
+			if (e == nullptr) {
+				if (new_intern == nullptr) {
+					new_intern = cast(StringIntern *)arena_alloc(&string_intern_arena, gb_offset_of(StringIntern, str) + len + 1, gb_align_of(StringIntern));
+					new_intern->hash = hash;
+					new_intern->len = len;
+					gb_memmove(new_intern->str, text, len);
+					new_intern->str[len] = 0;
+				}
+				if (t->slots[i].compare_exchange_strong(e, new_intern, std::memory_order_acq_rel, std::memory_order_acquire)) {
+					isize count = t->count.fetch_add(1, std::memory_order_relaxed) + 1;
+					if (count*2 > t->capacity && !t->growing.exchange(true, std::memory_order_acq_rel)) {
+						string_intern_grow(t);
+					}
+					return new_intern->str;
+				}
+				// NOTE: Another thread filled the slot first, which may have been with the same string
+				string_intern_lost_race_count.fetch_add(1, std::memory_order_relaxed);
+			}
+			if (e == STRING_INTERN_MOVED) {
+				break;
+			}
+			if (e->hash == hash && e->len == len && gb_memcompare(e->str, text, len) == 0) {
+				return e->str;
 			}
 		}
+		t = string_intern_wait_for_next(t);
 	}
-
-	StringIntern *new_intern = cast(StringIntern *)arena_alloc(&string_intern_arena, gb_offset_of(StringIntern, str) + len + 1, gb_align_of(StringIntern));
-	new_intern->len = len;
-	new_intern->next = found ? *found : nullptr;
-	gb_memmove(new_intern->str, text, len);
-	new_intern->str[len] = 0;
-	map_set(&string_intern_map, key, new_intern);
-	return new_intern->str;
 }
 
 char const *string_intern(String const &string) {
@@ -364,7 +463,7 @@ char const *string_intern(String const &string) {
 }
 
 void init_string_interner(void) {
-	map_init(&string_intern_map, heap_allocator());
+	string_intern_table.store(string_intern_table_make(STRING_INTERN_INITIAL_CAPACITY), std::memory_order_release);
 }
 
 
@@ -770,6 +869,52 @@ LoadedFileError load_file_32(char const *fullpath, LoadedFile *memory_mapped_fil
 			}
 			return err;
 		}
+	#elif defined(GB_SYSTEM_LINUX)
+		int fd = open(fullpath, O_RDONLY|O_CLOEXEC);
+		if (fd < 0) {
+			switch (errno) {
+			case ENOENT:
+			case ENOTDIR:
+				return LoadedFile_NotExists;
+			case EACCES:
+			case EPERM:
+				return LoadedFile_Permission;
+			}
+			return LoadedFile_Invalid;
+		}
+
+		struct stat st = {};
+		if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+			i64 file_size = cast(i64)st.st_size;
+			if (file_size > I32_MAX) {
+				close(fd);
+				return LoadedFile_FileTooLarge;
+			}
+			if (file_size == 0) {
+				close(fd);
+				memory_mapped_file->handle = nullptr;
+				memory_mapped_file->data   = nullptr;
+				memory_mapped_file->size   = 0;
+				return LoadedFile_Empty;
+			}
+
+			// NOTE: The rest of the last page of a mapping is zero filled, which gives the
+			// tokenizer its trailing NUL. If the file fills its last page exactly, there is no
+			// such byte, so the contents are copied instead.
+			i64 page_size = cast(i64)sysconf(_SC_PAGESIZE);
+			if (page_size > 0 && (file_size % page_size) != 0) {
+				void *file_data = mmap(nullptr, cast(size_t)file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+				if (file_data != MAP_FAILED) {
+					close(fd);
+					madvise(file_data, cast(size_t)file_size, MADV_SEQUENTIAL);
+					memory_mapped_file->handle = file_data;
+					memory_mapped_file->data   = file_data;
+					memory_mapped_file->size   = cast(i32)file_size;
+					return err;
+				}
+			}
+		}
+		close(fd);
 	#endif
 	}
 	
@@ -808,6 +953,8 @@ LoadedFileError load_file_32(char const *fullpath, LoadedFile *memory_mapped_fil
 #define USE_DAMERAU_LEVENSHTEIN 1
 
 isize levenstein_distance_case_insensitive(String const &a, String const &b) {
+	TEMPORARY_ALLOCATOR_GUARD();
+
 	isize w = b.len+1;
 	isize h = a.len+1;
 	isize *matrix = gb_alloc_array(temporary_allocator(), isize, w*h);
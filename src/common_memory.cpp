@@ -311,10 +311,59 @@ gbAllocator permanent_allocator() {
 	return arena_allocator(&permanent_arena);
 }
 
+
+struct TempArenaMemory {
+	Arena *      arena;
+	MemoryBlock *block;
+	isize        used;
+};
+
+TempArenaMemory temp_arena_memory_begin(Arena *arena) {
+	TempArenaMemory temp = {};
+	temp.arena = arena;
+	temp.block = arena->curr_block;
+	temp.used  = arena->curr_block ? arena->curr_block->used : 0;
+	return temp;
+}
+
+void temp_arena_memory_end(TempArenaMemory const &temp) {
+	Arena *arena = temp.arena;
+	while (arena->curr_block != temp.block) {
+		MemoryBlock *free_block = arena->curr_block;
+		GB_ASSERT_MSG(free_block != nullptr, "Mismatched temporary arena memory begin/end");
+		arena->curr_block = free_block->prev;
+		virtual_memory_dealloc(free_block);
+	}
+	MemoryBlock *block = arena->curr_block;
+	if (block != nullptr) {
+		GB_ASSERT(temp.used <= block->used);
+		// NOTE: Memory from an arena is expected to be zeroed, so clear what is being reused
+		zero_size(block->base + temp.used, block->used - temp.used);
+		block->used = temp.used;
+	}
+}
+
+
+// NOTE: Each thread has its own temporary arena. Anything allocated from it is freed at the
+// end of the innermost TEMPORARY_ALLOCATOR_GUARD, otherwise it lives as long as the thread does
+gb_global gb_thread_local Arena temporary_arena = {nullptr, DEFAULT_MINIMUM_BLOCK_SIZE, true};
 gbAllocator temporary_allocator() {
-	return permanent_allocator();
+	return arena_allocator(&temporary_arena);
 }
 
+struct TemporaryAllocatorGuard {
+	TempArenaMemory temp;
+
+	TemporaryAllocatorGuard() {
+		this->temp = temp_arena_memory_begin(&temporary_arena);
+	}
+	~TemporaryAllocatorGuard() {
+		temp_arena_memory_end(this->temp);
+	}
+};
+
+#define TEMPORARY_ALLOCATOR_GUARD() TemporaryAllocatorGuard GB_DEFER_3(_temporary_allocator_guard_){}
+
 
 
 
@@ -85,6 +85,9 @@ enum EntityFlag : u64 {
 	EntityFlag_Require = 1ull<<50,
 	EntityFlag_ByPtr = 1ull<<51, // enforce parameter is passed by pointer
 
+	EntityFlag_MinimumDependency = 1ull<<52, // within `CheckerInfo::minimum_dependency_set`
+	EntityFlag_CodeGenName       = 1ull<<53, // backend name cached in `ir_mangled_name`/`link_name`
+
 	EntityFlag_Overridden    = 1ull<<63,
 };
 
@@ -278,6 +281,11 @@ bool is_entity_kind_exported(EntityKind kind, bool allow_builtin = false) {
 	return true;
 }
 
+// NOTE: Equivalent to `ptr_set_exists(&info->minimum_dependency_set, e)` but without the hash lookup
+gb_inline bool is_entity_a_minimum_dependency(Entity *e) {
+	return e != nullptr && (e->flags.load(std::memory_order_relaxed) & EntityFlag_MinimumDependency) != 0;
+}
+
 bool is_entity_exported(Entity *e, bool allow_builtin = false) {
 	// TODO(bill): Determine the actual exportation rules for imports of entities
 	GB_ASSERT(e != nullptr);
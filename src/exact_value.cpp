@@ -3,8 +3,6 @@
 // TODO(bill): Big numbers
 // IMPORTANT TODO(bill): This needs to be completely fixed!!!!!!!!
 
-gb_global BlockingMutex hash_exact_value_mutex;
-
 struct Ast;
 struct HashKey;
 struct Type;
@@ -63,10 +61,9 @@ struct ExactValue {
 
 gb_global ExactValue const empty_exact_value = {};
 
+// NOTE: This is called from multiple threads when checking procedure bodies, and it does not
+// require a lock as the only shared state, the string interner, is lock-free
 uintptr hash_exact_value(ExactValue v) {
-	mutex_lock(&hash_exact_value_mutex);
-	defer (mutex_unlock(&hash_exact_value_mutex));
-	
 	switch (v.kind) {
 	case ExactValue_Invalid:
 		return 0;
@@ -76,8 +73,12 @@ uintptr hash_exact_value(ExactValue v) {
 		return ptr_map_hash_key(string_intern(v.value_string));
 	case ExactValue_Integer:
 		{
-			u32 key = gb_fnv32a(v.value_integer.dp, gb_size_of(*v.value_integer.dp) * v.value_integer.used);
-			u8 last = (u8)v.value_integer.sign;
+			BigInt const &i = v.value_integer;
+			if (i.big == nullptr) {
+				return gb_fnv32a(&i.small, gb_size_of(i.small));
+			}
+			u32 key = gb_fnv32a(i.big->dp, gb_size_of(*i.big->dp) * i.big->used);
+			u8 last = (u8)i.big->sign;
 			return (key ^ last) * 0x01000193;
 		}
 	case ExactValue_Float:
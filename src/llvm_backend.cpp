@@ -82,17 +82,46 @@ void lb_set_entity_from_other_modules_linkage_correctly(lbModule *other_module,
 	if (other_module == nullptr) {
 		return;
 	}
-	char const *cname = alloc_cstring(temporary_allocator(), name);
+	// NOTE: The other module may be being generated on another thread, so the linkage
+	// is changed once all of the procedures have been generated
+	lbGenerator *gen = other_module->gen;
+	mutex_lock(&gen->linkage_mutex);
+	array_add(&gen->pending_external_linkages, lbEntityLinkage{other_module, e, name});
+	mutex_unlock(&gen->linkage_mutex);
+}
 
-	LLVMValueRef other_global = nullptr;
-	if (e->kind == Entity_Variable) {
-		other_global = LLVMGetNamedGlobal(other_module->mod, cname);
-	} else if (e->kind == Entity_Procedure) {
-		other_global = LLVMGetNamedFunction(other_module->mod, cname);
+void lb_add_lto_internal_name(lbModule *m, Entity *e, String const &name) {
+	if (!USE_SEPARATE_MODULES || !build_context.lto) {
+		return;
+	}
+	u64 const keep_flags = EntityFlag_CustomLinkage_Internal|EntityFlag_CustomLinkage_Strong|EntityFlag_CustomLinkage_Weak|EntityFlag_CustomLinkage_LinkOnce|EntityFlag_Require;
+	if (e != nullptr && (e->flags & keep_flags) != 0) {
+		return;
 	}
-	if (other_global) {
-		LLVMSetLinkage(other_global, LLVMExternalLinkage);
+	array_add(&m->lto_internal_names, name);
+}
+
+void lb_apply_pending_external_linkages(lbGenerator *gen) {
+	mutex_lock(&gen->linkage_mutex);
+	defer (mutex_unlock(&gen->linkage_mutex));
+
+	for_array(i, gen->pending_external_linkages) {
+		TEMPORARY_ALLOCATOR_GUARD();
+
+		lbEntityLinkage const &l = gen->pending_external_linkages[i];
+		char const *cname = alloc_cstring(temporary_allocator(), l.name);
+
+		LLVMValueRef other_global = nullptr;
+		if (l.entity->kind == Entity_Variable) {
+			other_global = LLVMGetNamedGlobal(l.other_module->mod, cname);
+		} else if (l.entity->kind == Entity_Procedure) {
+			other_global = LLVMGetNamedFunction(l.other_module->mod, cname);
+		}
+		if (other_global) {
+			LLVMSetLinkage(other_global, LLVMExternalLinkage);
+		}
 	}
+	array_clear(&gen->pending_external_linkages);
 }
 
 void lb_emit_init_context(lbProcedure *p, lbAddr addr) {
@@ -155,15 +184,15 @@ lbValue lb_get_equal_proc_for_type(lbModule *m, Type *type) {
 		return {compare_proc->value, compare_proc->type};
 	}
 
-	static u32 proc_index = 0;
-
-	char buf[16] = {};
-	isize n = gb_snprintf(buf, 16, "__$equal%u", ++proc_index);
+	char buf[32] = {};
+	isize n = gb_snprintf(buf, 32, "__$equal%u", ++m->equal_proc_index);
 	char *str = gb_alloc_str_len(permanent_allocator(), buf, n-1);
 	String proc_name = make_string_c(str);
 
 	lbProcedure *p = lb_create_dummy_procedure(m, proc_name, t_equal_proc);
 	map_set(&m->equal_procs, type, p);
+	// NOTE: these are generated per module and only numbered per module, so they must not be visible outside of it
+	LLVMSetLinkage(p->value, LLVMInternalLinkage);
 	lb_begin_procedure_body(p);
 
 	LLVMValueRef x = LLVMGetParam(p->value, 0);
@@ -308,15 +337,15 @@ lbValue lb_get_hasher_proc_for_type(lbModule *m, Type *type) {
 		return {(*found)->value, (*found)->type};
 	}
 
-	static u32 proc_index = 0;
-
-	char buf[16] = {};
-	isize n = gb_snprintf(buf, 16, "__$hasher%u", ++proc_index);
+	char buf[32] = {};
+	isize n = gb_snprintf(buf, 32, "__$hasher%u", ++m->hasher_proc_index);
 	char *str = gb_alloc_str_len(permanent_allocator(), buf, n-1);
 	String proc_name = make_string_c(str);
 
 	lbProcedure *p = lb_create_dummy_procedure(m, proc_name, t_hasher_proc);
 	map_set(&m->hasher_procs, type, p);
+	// NOTE: see lb_get_equal_proc_for_type
+	LLVMSetLinkage(p->value, LLVMInternalLinkage);
 	lb_begin_procedure_body(p);
 	defer (lb_end_procedure_body(p));
 
@@ -455,6 +484,9 @@ lbValue lb_get_hasher_proc_for_type(lbModule *m, Type *type) {
 
 
 lbValue lb_generate_anonymous_proc_lit(lbModule *m, String const &prefix_name, Ast *expr, lbProcedure *parent) {
+	mutex_lock(&m->gen->anonymous_proc_lits_mutex);
+	defer (mutex_unlock(&m->gen->anonymous_proc_lits_mutex));
+
 	lbProcedure **found = map_get(&m->gen->anonymous_proc_lits, expr);
 	if (found) {
 		return lb_find_procedure_value_from_entity(m, (*found)->entity);
@@ -511,6 +543,8 @@ lbValue lb_gen_map_header(lbProcedure *p, lbValue map_val_ptr, Type *map_type) {
 	gb_unused(val_type);
 
 	GB_ASSERT(map_type->Map.entry_type->kind == Type_Struct);
+	// NOTE: The entry type may be shared with procedures being generated on other threads
+	mutex_lock(&g_type_mutex);
 	map_type->Map.entry_type->cached_size = -1;
 	map_type->Map.entry_type->Struct.are_offsets_set = false;
 	
@@ -522,6 +556,7 @@ lbValue lb_gen_map_header(lbProcedure *p, lbValue map_val_ptr, Type *map_type) {
 
 	i64 value_offset = type_offset_of(map_type->Map.entry_type, 3);
 	i64 value_size   = type_size_of  (map_type->Map.value);
+	mutex_unlock(&g_type_mutex);
 	
 	
 	Type *map_header_base = base_type(t_map_header);
@@ -999,6 +1034,11 @@ String lb_filepath_ll_for_module(lbModule *m) {
 
 	if (m->pkg) {
 		path = concatenate3_strings(permanent_allocator(), path, STR_LIT("-"), m->pkg->name);
+		if (m->codegen_unit != 0) {
+			char unit[32] = {};
+			isize unit_len = gb_snprintf(unit, gb_size_of(unit), "-%td", m->codegen_unit);
+			path = concatenate_strings(permanent_allocator(), path, make_string(cast(u8 *)unit, unit_len-1));
+		}
 	} else if (USE_SEPARATE_MODULES) {
 		path = concatenate_strings(permanent_allocator(), path, STR_LIT("-builtin"));
 	}
@@ -1015,6 +1055,11 @@ String lb_filepath_obj_for_module(lbModule *m) {
 
 	if (m->pkg) {
 		path = concatenate3_strings(permanent_allocator(), path, STR_LIT("-"), m->pkg->name);
+		if (m->codegen_unit != 0) {
+			char unit[32] = {};
+			isize unit_len = gb_snprintf(unit, gb_size_of(unit), "-%td", m->codegen_unit);
+			path = concatenate_strings(permanent_allocator(), path, make_string(cast(u8 *)unit, unit_len-1));
+		}
 	}
 
 	String ext = {};
@@ -1177,6 +1222,7 @@ WORKER_TASK_PROC(lb_llvm_function_pass_worker_proc) {
 struct lbLLVMModulePassWorkerData {
 	lbModule *m;
 	LLVMTargetMachineRef target_machine;
+	isize estimated_size;
 };
 
 WORKER_TASK_PROC(lb_llvm_module_pass_worker_proc) {
@@ -1187,6 +1233,106 @@ WORKER_TASK_PROC(lb_llvm_module_pass_worker_proc) {
 	return 0;
 }
 
+// NOTE: The entire optimization pipeline for a single module, as each module
+// has its own LLVMContextRef when using separate modules, this can be run on any thread
+WORKER_TASK_PROC(lb_llvm_pass_pipeline_worker_proc) {
+	auto wd = cast(lbLLVMModulePassWorkerData *)data;
+	lbModule *m = wd->m;
+
+	lb_llvm_function_pass_worker_proc(m);
+
+	lb_run_remove_unused_function_pass(m);
+	lb_run_remove_unused_globals_pass(m);
+
+	if (!build_context.lto) {
+		// NOTE: With -lto, the module passes are only run once the modules have been linked together
+		lb_llvm_module_pass_worker_proc(wd);
+	}
+	return 0;
+}
+
+// NOTE: A rough estimate of the amount of work the LLVM passes will do on a module
+isize lb_module_estimated_size(lbModule *m) {
+	isize size = 0;
+	for (LLVMValueRef fn = LLVMGetFirstFunction(m->mod); fn != nullptr; fn = LLVMGetNextFunction(fn)) {
+		size += 1 + cast(isize)LLVMCountBasicBlocks(fn);
+	}
+	return size;
+}
+
+GB_COMPARE_PROC(lb_module_pass_worker_data_size_cmp) {
+	auto *x = *(lbLLVMModulePassWorkerData **)a;
+	auto *y = *(lbLLVMModulePassWorkerData **)b;
+	// NOTE: Largest first
+	return -i64_cmp(x->estimated_size, y->estimated_size);
+}
+
+// NOTE: Each separate module has been generated and optimized on its own (in parallel) which
+// means that nothing can be inlined across modules (e.g. small procedures from `runtime` or `core:math`).
+// For -lto, the modules are then linked into the default module through bitcode (as each module has its
+// own LLVMContextRef), the definitions which were only external so that other modules could reference
+// them are made internal, and only then are the module passes run, once, over the whole program
+void lb_link_time_optimization(lbGenerator *gen, LLVMTargetMachineRef target_machine) {
+	lbModule *default_module = &gen->default_module;
+
+	for_array(i, gen->modules.entries) {
+		lbModule *m = gen->modules.entries[i].value;
+		if (m == default_module) {
+			continue;
+		}
+
+		size_t name_len = 0;
+		char const *name = LLVMGetModuleIdentifier(m->mod, &name_len);
+		char *module_name = alloc_cstring(permanent_allocator(), make_string(cast(u8 const *)name, name_len));
+
+		if (!lb_is_module_empty(m)) {
+			LLVMMemoryBufferRef bitcode = LLVMWriteBitcodeToMemoryBuffer(m->mod);
+			LLVMModuleRef src = nullptr;
+			if (LLVMParseBitcodeInContext2(default_module->ctx, bitcode, &src)) {
+				gb_printf_err("LLVM Error: unable to read the bitcode of module %s for link time optimization\n", module_name);
+				gb_exit(1);
+			}
+			LLVMDisposeMemoryBuffer(bitcode);
+
+			// NOTE: `src` is destroyed by the linker
+			if (LLVMLinkModules2(default_module->mod, src)) {
+				gb_printf_err("LLVM Error: unable to link module %s for link time optimization\n", module_name);
+				gb_exit(1);
+			}
+		}
+
+		for_array(j, m->lto_internal_names) {
+			array_add(&default_module->lto_internal_names, m->lto_internal_names[j]);
+		}
+
+		// NOTE: Replace it with an empty module so that nothing is emitted for it
+		LLVMDisposeModule(m->mod);
+		m->mod = LLVMModuleCreateWithNameInContext(module_name, m->ctx);
+	}
+
+	for_array(i, default_module->lto_internal_names) {
+		TEMPORARY_ALLOCATOR_GUARD();
+		char const *cname = alloc_cstring(temporary_allocator(), default_module->lto_internal_names[i]);
+
+		LLVMValueRef value = LLVMGetNamedFunction(default_module->mod, cname);
+		if (value == nullptr) {
+			value = LLVMGetNamedGlobal(default_module->mod, cname);
+		}
+		if (value != nullptr && !LLVMIsDeclaration(value) && LLVMGetLinkage(value) == LLVMExternalLinkage) {
+			LLVMSetLinkage(value, LLVMInternalLinkage);
+			LLVMSetVisibility(value, LLVMDefaultVisibility);
+		}
+	}
+
+	lb_run_remove_unused_function_pass(default_module);
+	lb_run_remove_unused_globals_pass(default_module);
+
+	lbLLVMModulePassWorkerData wd = {};
+	wd.m = default_module;
+	wd.target_machine = target_machine;
+	lb_llvm_module_pass_worker_proc(&wd);
+}
+
 
 void lb_generate_procedure(lbModule *m, lbProcedure *p) {
 	if (p->is_done) {
@@ -1227,6 +1373,23 @@ void lb_generate_procedure(lbModule *m, lbProcedure *p) {
 	}
 }
 
+WORKER_TASK_PROC(lb_generate_procedures_worker_proc) {
+	lbModule *m = cast(lbModule *)data;
+	// NOTE: `procedures_to_generate` may grow whilst iterating (e.g. nested procedures)
+	for_array(i, m->procedures_to_generate) {
+		lbProcedure *p = m->procedures_to_generate[i];
+		lb_generate_procedure(m, p);
+	}
+	return 0;
+}
+
+GB_COMPARE_PROC(lb_module_procedure_count_cmp) {
+	lbModule *x = *(lbModule **)a;
+	lbModule *y = *(lbModule **)b;
+	// NOTE: Largest first
+	return -i64_cmp(x->procedures_to_generate.count, y->procedures_to_generate.count);
+}
+
 
 void lb_generate_code(lbGenerator *gen) {
 	TIME_SECTION("LLVM Initializtion");
@@ -1239,8 +1402,6 @@ void lb_generate_code(lbGenerator *gen) {
 	lbModule *default_module = &gen->default_module;
 	CheckerInfo *info = gen->info;
 
-	auto *min_dep_set = &info->minimum_dependency_set;
-
 	switch (build_context.metrics.arch) {
 	case TargetArch_amd64: 
 	case TargetArch_i386:
@@ -1452,6 +1613,8 @@ void lb_generate_code(lbGenerator *gen) {
 			LLVMSetInitializer(g, LLVMConstNull(lb_type(m, t)));
 			if (!USE_SEPARATE_MODULES) {
 				LLVMSetLinkage(g, LLVMInternalLinkage);
+			} else {
+				lb_add_lto_internal_name(m, nullptr, str_lit(LB_TYPE_INFO_DATA_NAME));
 			}
 
 			lbValue value = {};
@@ -1577,7 +1740,7 @@ void lb_generate_code(lbGenerator *gen) {
 			continue;
 		}
 
-		if (!ptr_set_exists(min_dep_set, e)) {
+		if (!is_entity_a_minimum_dependency(e)) {
 			continue;
 		}
 		DeclInfo *decl = decl_info_of_entity(e);
@@ -1629,6 +1792,7 @@ void lb_generate_code(lbGenerator *gen) {
 		} else if (!is_foreign) {
 			if (USE_SEPARATE_MODULES) {
 				LLVMSetLinkage(g.value, LLVMExternalLinkage);
+				lb_add_lto_internal_name(m, e, name);
 			} else {
 				LLVMSetLinkage(g.value, LLVMInternalLinkage);
 			}
@@ -1739,14 +1903,14 @@ void lb_generate_code(lbGenerator *gen) {
 			}
 		}
 
-		if (!polymorphic_struct && !ptr_set_exists(min_dep_set, e)) {
+		if (!polymorphic_struct && !is_entity_a_minimum_dependency(e)) {
 			// NOTE(bill): Nothing depends upon it so doesn't need to be built
 			continue;
 		}
 
 		lbModule *m = &gen->default_module;
 		if (USE_SEPARATE_MODULES) {
-			m = lb_pkg_module(gen, e->pkg);
+			m = lb_entity_module(gen, e);
 		}
 
 		String mangled_name = lb_get_entity_name(m, e);
@@ -1765,11 +1929,37 @@ void lb_generate_code(lbGenerator *gen) {
 	}
 
 	TIME_SECTION("LLVM Procedure Generation");
-	for_array(j, gen->modules.entries) {
-		lbModule *m = gen->modules.entries[j].value;
-		for_array(i, m->procedures_to_generate) {
-			lbProcedure *p = m->procedures_to_generate[i];
-			lb_generate_procedure(m, p);
+	if (do_threading) {
+		// NOTE: Each package has its own module (and LLVMContextRef) so their procedures can be
+		// generated in parallel. The default module is generated afterwards on this thread as it may
+		// be referenced by every other module (e.g. Objective-C globals)
+		auto modules_to_generate = array_make<lbModule *>(heap_allocator(), 0, gen->modules.entries.count);
+		defer (array_free(&modules_to_generate));
+
+		for_array(j, gen->modules.entries) {
+			lbModule *m = gen->modules.entries[j].value;
+			if (m != default_module && m->procedures_to_generate.count != 0) {
+				array_add(&modules_to_generate, m);
+			}
+		}
+		gb_sort_array(modules_to_generate.data, modules_to_generate.count, lb_module_procedure_count_cmp);
+
+		for_array(j, modules_to_generate) {
+			global_thread_pool_add_task(lb_generate_procedures_worker_proc, modules_to_generate[j]);
+		}
+		thread_pool_wait(&global_thread_pool);
+
+		for_array(i, default_module->procedures_to_generate) {
+			lbProcedure *p = default_module->procedures_to_generate[i];
+			lb_generate_procedure(default_module, p);
+		}
+	} else {
+		for_array(j, gen->modules.entries) {
+			lbModule *m = gen->modules.entries[j].value;
+			for_array(i, m->procedures_to_generate) {
+				lbProcedure *p = m->procedures_to_generate[i];
+				lb_generate_procedure(m, p);
+			}
 		}
 	}
 
@@ -1789,6 +1979,8 @@ void lb_generate_code(lbGenerator *gen) {
 
 	lb_finalize_objc_names(objc_names);
 
+	lb_apply_pending_external_linkages(gen);
+
 	if (build_context.ODIN_DEBUG) {
 		TIME_SECTION("LLVM Debug Info Complete Types and Finalize");
 		for_array(j, gen->modules.entries) {
@@ -1802,26 +1994,50 @@ void lb_generate_code(lbGenerator *gen) {
 
 
 
-	TIME_SECTION("LLVM Function Pass");
-	for_array(i, gen->modules.entries) {
-		lbModule *m = gen->modules.entries[i].value;
+	TIME_SECTION("LLVM Function Pass and Module Pass");
+	{
+		auto pass_worker_data = array_make<lbLLVMModulePassWorkerData *>(heap_allocator(), 0, gen->modules.entries.count);
+		defer (array_free(&pass_worker_data));
 
-		lb_llvm_function_pass_worker_proc(m);
-	}
+		for_array(i, gen->modules.entries) {
+			lbModule *m = gen->modules.entries[i].value;
 
-	TIME_SECTION("LLVM Module Pass");
+			auto wd = gb_alloc_item(permanent_allocator(), lbLLVMModulePassWorkerData);
+			wd->m = m;
+			wd->target_machine = target_machines[i];
+			array_add(&pass_worker_data, wd);
+		}
 
-	for_array(i, gen->modules.entries) {
-		lbModule *m = gen->modules.entries[i].value;
-		
-		lb_run_remove_unused_function_pass(m);
-		lb_run_remove_unused_globals_pass(m);
+		if (do_threading && pass_worker_data.count > 1) {
+			// NOTE: Schedule the largest modules first so that a single large module
+			// is not started last and left running on its own
+			for_array(i, pass_worker_data) {
+				pass_worker_data[i]->estimated_size = lb_module_estimated_size(pass_worker_data[i]->m);
+			}
+			gb_sort_array(pass_worker_data.data, pass_worker_data.count, lb_module_pass_worker_data_size_cmp);
 
-		auto wd = gb_alloc_item(permanent_allocator(), lbLLVMModulePassWorkerData);
-		wd->m = m;
-		wd->target_machine = target_machines[i];
+			for_array(i, pass_worker_data) {
+				global_thread_pool_add_task(lb_llvm_pass_pipeline_worker_proc, pass_worker_data[i]);
+			}
+			thread_pool_wait(&global_thread_pool);
+		} else {
+			for_array(i, pass_worker_data) {
+				lb_llvm_pass_pipeline_worker_proc(pass_worker_data[i]);
+			}
+		}
+	}
 
-		lb_llvm_module_pass_worker_proc(wd);
+
+	if (USE_SEPARATE_MODULES && build_context.lto) {
+		TIME_SECTION("LLVM Link Time Optimization");
+
+		LLVMTargetMachineRef target_machine = nullptr;
+		for_array(i, gen->modules.entries) {
+			if (gen->modules.entries[i].value == default_module) {
+				target_machine = target_machines[i];
+			}
+		}
+		lb_link_time_optimization(gen, target_machine);
 	}
 
 
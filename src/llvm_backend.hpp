@@ -4,8 +4,10 @@
 #include "llvm-c/Target.h"
 #include "llvm-c/Analysis.h"
 #include "llvm-c/Object.h"
+#include "llvm-c/BitReader.h"
 #include "llvm-c/BitWriter.h"
 #include "llvm-c/DebugInfo.h"
+#include "llvm-c/Linker.h"
 #include "llvm-c/Transforms/AggressiveInstCombine.h"
 #include "llvm-c/Transforms/InstCombine.h"
 #include "llvm-c/Transforms/IPO.h"
@@ -19,8 +21,10 @@
 #include <llvm-c/Target.h>
 #include <llvm-c/Analysis.h>
 #include <llvm-c/Object.h>
+#include <llvm-c/BitReader.h>
 #include <llvm-c/BitWriter.h>
 #include <llvm-c/DebugInfo.h>
+#include <llvm-c/Linker.h>
 #include <llvm-c/Transforms/AggressiveInstCombine.h>
 #include <llvm-c/Transforms/InstCombine.h>
 #include <llvm-c/Transforms/IPO.h>
@@ -113,6 +117,7 @@ struct lbModule {
 
 	CheckerInfo *info;
 	AstPackage *pkg; // associated
+	isize codegen_unit; // 0 for the main module of `pkg`, otherwise one of its extra codegen units
 
 	PtrMap<Type *, LLVMTypeRef> types;
 	PtrMap<void *, lbStructFieldRemapping> struct_field_remapping; // Key: LLVMTypeRef or Type *
@@ -131,6 +136,8 @@ struct lbModule {
 
 	PtrMap<Type *, lbProcedure *> equal_procs;
 	PtrMap<Type *, lbProcedure *> hasher_procs;
+	u32 equal_proc_index;
+	u32 hasher_proc_index;
 
 	u32 nested_type_name_guid;
 
@@ -146,6 +153,14 @@ struct lbModule {
 
 	StringMap<lbAddr> objc_classes;
 	StringMap<lbAddr> objc_selectors;
+
+	Array<String> lto_internal_names; // definitions which are only external so that other modules can reference them
+};
+
+struct lbEntityLinkage {
+	lbModule *other_module;
+	Entity *  entity;
+	String    name;
 };
 
 struct lbGenerator {
@@ -155,16 +170,25 @@ struct lbGenerator {
 	Array<String> output_temp_paths;
 	String   output_base;
 	String   output_name;
-	PtrMap<AstPackage *, lbModule *> modules; 
+	PtrMap<void *, lbModule *> modules; // Key: AstPackage * or lbModule * (an extra codegen unit of a package)
+	PtrMap<Entity *, lbModule *> codegen_unit_modules; // procedures placed in an extra codegen unit of their package
 	PtrMap<LLVMContextRef, lbModule *> modules_through_ctx; 
 	lbModule default_module;
 
+	RecursiveMutex anonymous_proc_lits_mutex;
 	PtrMap<Ast *, lbProcedure *> anonymous_proc_lits; 
 
 	BlockingMutex foreign_mutex;
 	PtrSet<Entity *> foreign_libraries_set;
 	Array<Entity *>  foreign_libraries;
 
+	// NOTE: Procedures are generated in parallel across modules, so any state which is shared
+	// between modules (or modules which are not the one being generated) must be guarded
+	BlockingMutex default_module_mutex; // Objective-C globals which are added to the default module
+
+	BlockingMutex linkage_mutex;
+	Array<lbEntityLinkage> pending_external_linkages;
+
 	std::atomic<u32> global_array_index;
 	std::atomic<u32> global_generated_index;
 };
@@ -361,6 +385,7 @@ lbValue lb_emit_comp(lbProcedure *p, TokenKind op_kind, lbValue left, lbValue ri
 lbValue lb_emit_call(lbProcedure *p, lbValue value, Array<lbValue> const &args, ProcInlining inlining = ProcInlining_none, bool use_return_ptr_hint = false);
 lbValue lb_emit_conv(lbProcedure *p, lbValue value, Type *t);
 lbValue lb_emit_comp_against_nil(lbProcedure *p, TokenKind op_kind, lbValue x);
+lbValue lb_emit_memory_equal_inline(lbProcedure *p, lbValue lhs, lbValue rhs, i64 size);
 
 void lb_emit_jump(lbProcedure *p, lbBlock *target_block);
 void lb_emit_if(lbProcedure *p, lbValue cond, lbBlock *true_block, lbBlock *false_block);
@@ -460,6 +485,9 @@ lbValue lb_build_cond(lbProcedure *p, Ast *cond, lbBlock *true_block, lbBlock *f
 LLVMValueRef llvm_const_named_struct(lbModule *m, Type *t, LLVMValueRef *values, isize value_count_);
 LLVMValueRef llvm_const_named_struct_internal(LLVMTypeRef t, LLVMValueRef *values, isize value_count_);
 void lb_set_entity_from_other_modules_linkage_correctly(lbModule *other_module, Entity *e, String const &name);
+lbModule *lb_pkg_module(lbGenerator *gen, AstPackage *pkg);
+lbModule *lb_entity_module(lbGenerator *gen, Entity *e);
+void lb_add_lto_internal_name(lbModule *m, Entity *e, String const &name);
 
 lbValue lb_expr_untyped_const_to_typed(lbModule *m, Ast *expr, Type *t);
 bool lb_is_expr_untyped_const(Ast *expr);
@@ -497,6 +525,14 @@ i64 lb_max_zero_init_size(void) {
 #define LB_TYPE_INFO_USINGS_NAME     "__$type_info_usings_data"
 #define LB_TYPE_INFO_TAGS_NAME       "__$type_info_tags_data"
 
+// NOTE: Simple compare types up to this size are compared with inline loads rather than
+// calling 'memory_equal', 'memory_compare', or 'memory_compare_zero'
+#define LB_INLINE_MEMORY_COMPARE_MAX_SIZE 64
+
+// NOTE: With -use-separate-modules, a package is only split into multiple codegen units when
+// each unit would get at least this many bytes of procedure bodies (measured in source bytes)
+#define LB_CODEGEN_UNIT_MINIMUM_SIZE (64*1024)
+
 
 
 enum lbCallingConventionKind : unsigned {
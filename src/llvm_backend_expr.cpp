@@ -1315,7 +1315,7 @@ lbValue lb_build_binary_expr(lbProcedure *p, Ast *expr) {
 
 	TypeAndValue tv = type_and_value_of_expr(expr);
 	
-	if (is_type_matrix(be->left->tav.type) || is_type_matrix(be->right->tav.type)) {
+	if (is_type_matrix(be->left->tav().type) || is_type_matrix(be->right->tav().type)) {
 		lbValue left = lb_build_expr(p, be->left);
 		lbValue right = lb_build_expr(p, be->right);
 		return lb_emit_arith_matrix(p, be->op.kind, left, right, default_type(tv.type));
@@ -1357,12 +1357,12 @@ lbValue lb_build_binary_expr(lbProcedure *p, Ast *expr) {
 
 	case Token_CmpEq:
 	case Token_NotEq:
-		if (is_type_untyped_nil(be->right->tav.type)) {
+		if (is_type_untyped_nil(be->right->tav().type)) {
 			lbValue left = lb_build_expr(p, be->left);
 			lbValue cmp = lb_emit_comp_against_nil(p, be->op.kind, left);
 			Type *type = default_type(tv.type);
 			return lb_emit_conv(p, cmp, type);
-		} else if (is_type_untyped_nil(be->left->tav.type)) {
+		} else if (is_type_untyped_nil(be->left->tav().type)) {
 			lbValue right = lb_build_expr(p, be->right);
 			lbValue cmp = lb_emit_comp_against_nil(p, be->op.kind, right);
 			Type *type = default_type(tv.type);
@@ -1377,11 +1377,11 @@ lbValue lb_build_binary_expr(lbProcedure *p, Ast *expr) {
 			lbValue left = {};
 			lbValue right = {};
 
-			if (be->left->tav.mode == Addressing_Type) {
-				left = lb_typeid(p->module, be->left->tav.type);
+			if (be->left->tav().mode == Addressing_Type) {
+				left = lb_typeid(p->module, be->left->tav().type);
 			}
-			if (be->right->tav.mode == Addressing_Type) {
-				right = lb_typeid(p->module, be->right->tav.type);
+			if (be->right->tav().mode == Addressing_Type) {
+				right = lb_typeid(p->module, be->right->tav().type);
 			}
 			if (left.value == nullptr)  left  = lb_build_expr(p, be->left);
 			if (right.value == nullptr) right = lb_build_expr(p, be->right);
@@ -2197,12 +2197,74 @@ lbValue lb_emit_conv(lbProcedure *p, lbValue value, Type *t) {
 	return {};
 }
 
+LLVMValueRef lb_emit_unaligned_int_load(lbProcedure *p, LLVMValueRef byte_ptr, i64 offset, i64 size) {
+	LLVMContextRef ctx = p->module->ctx;
+	LLVMValueRef indices[1] = {LLVMConstInt(LLVMInt64TypeInContext(ctx), cast(unsigned long long)offset, false)};
+	LLVMValueRef ptr = LLVMBuildGEP(p->builder, byte_ptr, indices, 1, "");
+	LLVMTypeRef int_type = LLVMIntTypeInContext(ctx, cast(unsigned)(8*size));
+	ptr = LLVMBuildPointerCast(p->builder, ptr, LLVMPointerType(int_type, 0), "");
+	LLVMValueRef value = LLVMBuildLoad2(p->builder, int_type, ptr, "");
+	LLVMSetAlignment(value, 1);
+	return value;
+}
+
+// NOTE: Compares `size` bytes at `lhs` and `rhs`, or `lhs` against zero if `rhs.value` is null,
+// without calling into the runtime. The differences of each (unaligned) word are OR'd together so
+// the comparison is branchless, and LLVM is free to turn it into wider or vector loads.
+// Returns an `i1` which is true if the memory is equal.
+lbValue lb_emit_memory_equal_inline(lbProcedure *p, lbValue lhs, lbValue rhs, i64 size) {
+	GB_ASSERT(0 < size && size <= LB_INLINE_MEMORY_COMPARE_MAX_SIZE);
+	LLVMContextRef ctx = p->module->ctx;
+	LLVMTypeRef byte_ptr_type = LLVMPointerType(LLVMInt8TypeInContext(ctx), 0);
+	LLVMTypeRef word_type = LLVMInt64TypeInContext(ctx);
+
+	LLVMValueRef lhs_ptr = LLVMBuildPointerCast(p->builder, lhs.value, byte_ptr_type, "");
+	LLVMValueRef rhs_ptr = nullptr;
+	if (rhs.value != nullptr) {
+		rhs_ptr = LLVMBuildPointerCast(p->builder, rhs.value, byte_ptr_type, "");
+	}
+
+	LLVMValueRef diff = LLVMConstNull(word_type);
+	i64 offset = 0;
+	while (offset < size) {
+		i64 remaining = size - offset;
+		i64 chunk = 8;
+		if (remaining < 8) {
+			if (size >= 8) {
+				// NOTE: overlap with the previous word rather than doing several smaller loads
+				offset = size - 8;
+			} else {
+				chunk = remaining >= 4 ? 4 : remaining >= 2 ? 2 : 1;
+			}
+		}
+
+		LLVMValueRef x = lb_emit_unaligned_int_load(p, lhs_ptr, offset, chunk);
+		if (rhs_ptr != nullptr) {
+			LLVMValueRef y = lb_emit_unaligned_int_load(p, rhs_ptr, offset, chunk);
+			x = LLVMBuildXor(p->builder, x, y, "");
+		}
+		if (chunk < 8) {
+			x = LLVMBuildZExt(p->builder, x, word_type, "");
+		}
+		diff = LLVMBuildOr(p->builder, diff, x, "");
+		offset += chunk;
+	}
+
+	lbValue res = {};
+	res.type = t_llvm_bool;
+	res.value = LLVMBuildICmp(p->builder, LLVMIntEQ, diff, LLVMConstNull(word_type), "");
+	return res;
+}
+
 lbValue lb_compare_records(lbProcedure *p, TokenKind op_kind, lbValue left, lbValue right, Type *type) {
 	GB_ASSERT((is_type_struct(type) || is_type_union(type)) && is_type_comparable(type));
 	lbValue left_ptr  = lb_address_from_load_or_generate_local(p, left);
 	lbValue right_ptr = lb_address_from_load_or_generate_local(p, right);
 	lbValue res = {};
-	if (is_type_simple_compare(type)) {
+	if (is_type_simple_compare(type) && type_size_of(type) <= LB_INLINE_MEMORY_COMPARE_MAX_SIZE) {
+		res = lb_emit_memory_equal_inline(p, left_ptr, right_ptr, type_size_of(type));
+		res = lb_emit_conv(p, res, t_bool);
+	} else if (is_type_simple_compare(type)) {
 		// TODO(bill): Test to see if this is actually faster!!!!
 		auto args = array_make<lbValue>(permanent_allocator(), 3);
 		args[0] = lb_emit_conv(p, left_ptr, t_rawptr);
@@ -2278,6 +2340,13 @@ lbValue lb_emit_comp(lbProcedure *p, TokenKind op_kind, lbValue left, lbValue ri
 		lbValue lhs = lb_address_from_load_or_generate_local(p, left);
 		lbValue rhs = lb_address_from_load_or_generate_local(p, right);
 
+		if (type_size_of(tl) <= LB_INLINE_MEMORY_COMPARE_MAX_SIZE) {
+			lbValue res = lb_emit_memory_equal_inline(p, lhs, rhs, type_size_of(tl));
+			if (op_kind == Token_NotEq) {
+				res.value = LLVMBuildNot(p->builder, res.value, "");
+			}
+			return lb_emit_conv(p, res, t_bool);
+		}
 
 		// TODO(bill): Test to see if this is actually faster!!!!
 		auto args = array_make<lbValue>(permanent_allocator(), 3);
@@ -2325,7 +2394,14 @@ lbValue lb_emit_comp(lbProcedure *p, TokenKind op_kind, lbValue left, lbValue ri
 
 			return lb_addr_load(p, val);
 		} else {
-			if (is_type_simple_compare(tl) && (op_kind == Token_CmpEq || op_kind == Token_NotEq)) {
+			if (is_type_simple_compare(tl) && (op_kind == Token_CmpEq || op_kind == Token_NotEq) &&
+			    type_size_of(tl) <= LB_INLINE_MEMORY_COMPARE_MAX_SIZE) {
+				lbValue res = lb_emit_memory_equal_inline(p, lhs, rhs, type_size_of(tl));
+				if (op_kind == Token_NotEq) {
+					res.value = LLVMBuildNot(p->builder, res.value, "");
+				}
+				return lb_emit_conv(p, res, t_bool);
+			} else if (is_type_simple_compare(tl) && (op_kind == Token_CmpEq || op_kind == Token_NotEq)) {
 				// TODO(bill): Test to see if this is actually faster!!!!
 				auto args = array_make<lbValue>(permanent_allocator(), 3);
 				args[0] = lb_emit_conv(p, lhs, t_rawptr);
@@ -2789,8 +2865,15 @@ lbValue lb_emit_comp_against_nil(lbProcedure *p, TokenKind op_kind, lbValue x) {
 				}
 			}
 		} else if (is_type_struct(t) && type_has_nil(t)) {
-			auto args = array_make<lbValue>(permanent_allocator(), 2);
 			lbValue lhs = lb_address_from_load_or_generate_local(p, x);
+			if (0 < type_size_of(t) && type_size_of(t) <= LB_INLINE_MEMORY_COMPARE_MAX_SIZE) {
+				lbValue res = lb_emit_memory_equal_inline(p, lhs, {}, type_size_of(t));
+				if (op_kind == Token_NotEq) {
+					res.value = LLVMBuildNot(p->builder, res.value, "");
+				}
+				return res;
+			}
+			auto args = array_make<lbValue>(permanent_allocator(), 2);
 			args[0] = lb_emit_conv(p, lhs, t_rawptr);
 			args[1] = lb_const_int(p->module, t_int, type_size_of(t));
 			lbValue val = lb_emit_runtime_call(p, "memory_compare_zero", args);
@@ -3075,7 +3158,7 @@ lbValue lb_build_expr_internal(lbProcedure *p, Ast *expr) {
 	if (tv.value.kind != ExactValue_Invalid) {
 		// NOTE(bill): The commented out code below is just for debug purposes only
 		// if (is_type_untyped(type)) {
-		// 	gb_printf_err("%s %s : %s @ %p\n", token_pos_to_string(expr_pos), expr_to_string(expr), type_to_string(expr->tav.type), expr);
+		// 	gb_printf_err("%s %s : %s @ %p\n", token_pos_to_string(expr_pos), expr_to_string(expr), type_to_string(expr->tav().type), expr);
 		// 	GB_PANIC("%s\n", type_to_string(tv.type));
 		// }
 
@@ -3540,8 +3623,8 @@ lbAddr lb_build_addr_internal(lbProcedure *p, Ast *expr) {
 					a = lb_addr_get_ptr(p, addr);
 				}
 
-				GB_ASSERT(is_type_array(expr->tav.type));
-				return lb_addr_swizzle(a, expr->tav.type, swizzle_count, swizzle_indices);
+				GB_ASSERT(is_type_array(expr->tav().type));
+				return lb_addr_swizzle(a, expr->tav().type, swizzle_count, swizzle_indices);
 			}
 
 			Selection sel = lookup_field(type, selector, false);
@@ -3670,7 +3753,7 @@ lbAddr lb_build_addr_internal(lbProcedure *p, Ast *expr) {
 			return lb_addr_soa_variable(val, index, ie->index);
 		}
 
-		if (ie->expr->tav.mode == Addressing_SoaVariable) {
+		if (ie->expr->tav().mode == Addressing_SoaVariable) {
 			// SOA Structures for slices/dynamic arrays
 			GB_ASSERT(is_type_pointer(type_of_expr(ie->expr)));
 
@@ -4104,7 +4187,7 @@ lbAddr lb_build_addr_internal(lbProcedure *p, Ast *expr) {
 
 	case_ast_node(ce, CallExpr, expr);
 		BuiltinProcId builtin_id = BuiltinProc_Invalid;
-		if (ce->proc->tav.mode == Addressing_Builtin) {
+		if (ce->proc->tav().mode == Addressing_Builtin) {
 			Entity *e = entity_of_node(ce->proc);
 			if (e != nullptr) {
 				builtin_id = cast(BuiltinProcId)e->Builtin.id;
@@ -4112,7 +4195,7 @@ lbAddr lb_build_addr_internal(lbProcedure *p, Ast *expr) {
 				builtin_id = BuiltinProc_DIRECTIVE;
 			}
 		}
-		auto const &tv = expr->tav;
+		auto const &tv = expr->tav();
 		if (builtin_id == BuiltinProc_swizzle &&
 		    is_type_array(tv.type)) {
 		    	// NOTE(bill, 2021-08-09): `swizzle` has some bizarre semantics so it needs to be
@@ -4256,8 +4339,8 @@ lbAddr lb_build_addr_internal(lbProcedure *p, Ast *expr) {
 						}
 						if (is_ast_range(fv->field)) {
 							ast_node(ie, BinaryExpr, fv->field);
-							TypeAndValue lo_tav = ie->left->tav;
-							TypeAndValue hi_tav = ie->right->tav;
+							TypeAndValue lo_tav = ie->left->tav();
+							TypeAndValue hi_tav = ie->right->tav();
 							GB_ASSERT(lo_tav.mode == Addressing_Constant);
 							GB_ASSERT(hi_tav.mode == Addressing_Constant);
 
@@ -4278,7 +4361,7 @@ lbAddr lb_build_addr_internal(lbProcedure *p, Ast *expr) {
 							}
 
 						} else {
-							auto tav = fv->field->tav;
+							auto tav = fv->field->tav();
 							GB_ASSERT(tav.mode == Addressing_Constant);
 							i64 index = exact_value_to_i64(tav.value);
 
@@ -4349,8 +4432,8 @@ lbAddr lb_build_addr_internal(lbProcedure *p, Ast *expr) {
 						}
 						if (is_ast_range(fv->field)) {
 							ast_node(ie, BinaryExpr, fv->field);
-							TypeAndValue lo_tav = ie->left->tav;
-							TypeAndValue hi_tav = ie->right->tav;
+							TypeAndValue lo_tav = ie->left->tav();
+							TypeAndValue hi_tav = ie->right->tav();
 							GB_ASSERT(lo_tav.mode == Addressing_Constant);
 							GB_ASSERT(hi_tav.mode == Addressing_Constant);
 
@@ -4371,7 +4454,7 @@ lbAddr lb_build_addr_internal(lbProcedure *p, Ast *expr) {
 							}
 
 						} else {
-							auto tav = fv->field->tav;
+							auto tav = fv->field->tav();
 							GB_ASSERT(tav.mode == Addressing_Constant);
 							i64 index = exact_value_to_i64(tav.value);
 
@@ -4449,8 +4532,8 @@ lbAddr lb_build_addr_internal(lbProcedure *p, Ast *expr) {
 
 						if (is_ast_range(fv->field)) {
 							ast_node(ie, BinaryExpr, fv->field);
-							TypeAndValue lo_tav = ie->left->tav;
-							TypeAndValue hi_tav = ie->right->tav;
+							TypeAndValue lo_tav = ie->left->tav();
+							TypeAndValue hi_tav = ie->right->tav();
 							GB_ASSERT(lo_tav.mode == Addressing_Constant);
 							GB_ASSERT(hi_tav.mode == Addressing_Constant);
 
@@ -4471,8 +4554,8 @@ lbAddr lb_build_addr_internal(lbProcedure *p, Ast *expr) {
 							}
 
 						} else {
-							GB_ASSERT(fv->field->tav.mode == Addressing_Constant);
-							i64 index = exact_value_to_i64(fv->field->tav.value);
+							GB_ASSERT(fv->field->tav().mode == Addressing_Constant);
+							i64 index = exact_value_to_i64(fv->field->tav().value);
 
 							lbValue field_expr = lb_build_expr(p, fv->value);
 							GB_ASSERT(!is_type_tuple(field_expr.type));
@@ -4553,8 +4636,8 @@ lbAddr lb_build_addr_internal(lbProcedure *p, Ast *expr) {
 					ast_node(fv, FieldValue, elem);
 					if (is_ast_range(fv->field)) {
 						ast_node(ie, BinaryExpr, fv->field);
-						TypeAndValue lo_tav = ie->left->tav;
-						TypeAndValue hi_tav = ie->right->tav;
+						TypeAndValue lo_tav = ie->left->tav();
+						TypeAndValue hi_tav = ie->right->tav();
 						GB_ASSERT(lo_tav.mode == Addressing_Constant);
 						GB_ASSERT(hi_tav.mode == Addressing_Constant);
 
@@ -4572,9 +4655,9 @@ lbAddr lb_build_addr_internal(lbProcedure *p, Ast *expr) {
 							lb_emit_store(p, ep, value);
 						}
 					} else {
-						GB_ASSERT(fv->field->tav.mode == Addressing_Constant);
+						GB_ASSERT(fv->field->tav().mode == Addressing_Constant);
 
-						i64 field_index = exact_value_to_i64(fv->field->tav.value);
+						i64 field_index = exact_value_to_i64(fv->field->tav().value);
 
 						lbValue ev = lb_build_expr(p, fv->value);
 						lbValue value = lb_emit_conv(p, ev, et);
@@ -4694,8 +4777,8 @@ lbAddr lb_build_addr_internal(lbProcedure *p, Ast *expr) {
 						}
 						if (is_ast_range(fv->field)) {
 							ast_node(ie, BinaryExpr, fv->field);
-							TypeAndValue lo_tav = ie->left->tav;
-							TypeAndValue hi_tav = ie->right->tav;
+							TypeAndValue lo_tav = ie->left->tav();
+							TypeAndValue hi_tav = ie->right->tav();
 							GB_ASSERT(lo_tav.mode == Addressing_Constant);
 							GB_ASSERT(hi_tav.mode == Addressing_Constant);
 
@@ -4717,7 +4800,7 @@ lbAddr lb_build_addr_internal(lbProcedure *p, Ast *expr) {
 							}
 
 						} else {
-							auto tav = fv->field->tav;
+							auto tav = fv->field->tav();
 							GB_ASSERT(tav.mode == Addressing_Constant);
 							i64 index = exact_value_to_i64(tav.value);
 
@@ -4791,8 +4874,8 @@ lbAddr lb_build_addr_internal(lbProcedure *p, Ast *expr) {
 						}
 						if (is_ast_range(fv->field)) {
 							ast_node(ie, BinaryExpr, fv->field);
-							TypeAndValue lo_tav = ie->left->tav;
-							TypeAndValue hi_tav = ie->right->tav;
+							TypeAndValue lo_tav = ie->left->tav();
+							TypeAndValue hi_tav = ie->right->tav();
 							GB_ASSERT(lo_tav.mode == Addressing_Constant);
 							GB_ASSERT(hi_tav.mode == Addressing_Constant);
 
@@ -4813,7 +4896,7 @@ lbAddr lb_build_addr_internal(lbProcedure *p, Ast *expr) {
 							}
 
 						} else {
-							auto tav = fv->field->tav;
+							auto tav = fv->field->tav();
 							GB_ASSERT(tav.mode == Addressing_Constant);
 							i64 index = exact_value_to_i64(tav.value);
 
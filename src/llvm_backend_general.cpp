@@ -1,5 +1,9 @@
 void lb_add_debug_local_variable(lbProcedure *p, LLVMValueRef ptr, Type *type, Token const &token);
 
+// NOTE: Guards the names and code gen procedures cached on entities, which are
+// shared between all modules (a module may be `nullptr` when getting an entity's name)
+gb_global RecursiveMutex lb_entity_name_mutex;
+
 gb_global Entity *lb_global_type_info_data_entity   = {};
 gb_global lbAddr lb_global_type_info_member_types   = {};
 gb_global lbAddr lb_global_type_info_member_names   = {};
@@ -22,6 +26,9 @@ void lb_init_module(lbModule *m, Checker *c) {
 	if (m->pkg) {
 		module_name = gb_string_appendc(module_name, "-");
 		module_name = gb_string_append_length(module_name, m->pkg->name.text, m->pkg->name.len);
+		if (m->codegen_unit != 0) {
+			module_name = gb_string_append_fmt(module_name, "-%td", m->codegen_unit);
+		}
 	} else if (USE_SEPARATE_MODULES) {
 		module_name = gb_string_appendc(module_name, "-builtin");
 	}
@@ -73,6 +80,139 @@ void lb_init_module(lbModule *m, Checker *c) {
 
 	string_map_init(&m->objc_classes, a);
 	string_map_init(&m->objc_selectors, a);
+
+	array_init(&m->lto_internal_names, a);
+}
+
+struct lbCodegenUnitProcedure {
+	Entity *e;
+	isize   size;
+};
+
+GB_COMPARE_PROC(lb_codegen_unit_procedure_cmp) {
+	lbCodegenUnitProcedure const *x = cast(lbCodegenUnitProcedure const *)a;
+	lbCodegenUnitProcedure const *y = cast(lbCodegenUnitProcedure const *)b;
+	if (x->e->pkg != y->e->pkg) {
+		return isize_cmp(x->e->pkg->order, y->e->pkg->order);
+	}
+	// NOTE: Largest first, then by entity so that the units are the same between builds
+	if (x->size != y->size) {
+		return -isize_cmp(x->size, y->size);
+	}
+	return u64_cmp(x->e->id, y->e->id);
+}
+
+// NOTE: A rough estimate of the amount of code a procedure will generate
+isize lb_estimated_procedure_size(Entity *e) {
+	DeclInfo *decl = e->decl_info;
+	if (decl == nullptr || decl->proc_lit == nullptr || decl->proc_lit->kind != Ast_ProcLit) {
+		return 0;
+	}
+	Ast *body = decl->proc_lit->ProcLit.body;
+	if (body == nullptr || body->kind != Ast_BlockStmt) {
+		return 0;
+	}
+	return gb_max(body->BlockStmt.close.pos.offset - body->BlockStmt.open.pos.offset, 1);
+}
+
+// NOTE: With separate modules, a single large package (e.g. the init package or a large vendor
+// binding) would be a single module which is generated and optimized on one thread whilst the other
+// threads are idle. Its procedures are split across extra modules (codegen units) by their estimated
+// size, and references between the units are handled in the same way as references between packages.
+void lb_init_codegen_units(lbGenerator *gen, Checker *c) {
+	isize max_unit_count = build_context.codegen_units;
+	if (max_unit_count <= 1) {
+		return;
+	}
+
+	auto procs = array_make<lbCodegenUnitProcedure>(heap_allocator(), 0, c->info.entities.count);
+	defer (array_free(&procs));
+
+	// NOTE: An internal entity can only be referenced from the module which defines it,
+	// so a package with any of them is never split
+	PtrSet<AstPackage *> unsplittable_pkgs = {};
+	ptr_set_init(&unsplittable_pkgs, heap_allocator());
+	defer (ptr_set_destroy(&unsplittable_pkgs));
+
+	for_array(i, c->info.entities) {
+		Entity *e = c->info.entities[i];
+		if (e->pkg != nullptr && (e->flags & EntityFlag_CustomLinkage_Internal)) {
+			ptr_set_add(&unsplittable_pkgs, e->pkg);
+		}
+	}
+
+	for_array(i, c->info.entities) {
+		Entity *e = c->info.entities[i];
+		if (e->kind != Entity_Procedure || e->pkg == nullptr || e->Procedure.is_foreign) {
+			continue;
+		}
+		if ((e->scope->flags & ScopeFlag_File) == 0) {
+			continue;
+		}
+		if (ptr_set_exists(&unsplittable_pkgs, e->pkg)) {
+			continue;
+		}
+		if (!is_entity_a_minimum_dependency(e)) {
+			continue;
+		}
+		isize size = lb_estimated_procedure_size(e);
+		if (size > 0) {
+			array_add(&procs, lbCodegenUnitProcedure{e, size});
+		}
+	}
+	gb_sort_array(procs.data, procs.count, lb_codegen_unit_procedure_cmp);
+
+	auto units      = array_make<lbModule *>(heap_allocator(), 0, max_unit_count);
+	auto unit_sizes = array_make<isize>(heap_allocator(), 0, max_unit_count);
+	defer (array_free(&units));
+	defer (array_free(&unit_sizes));
+
+	for (isize lo = 0; lo < procs.count; /**/) {
+		AstPackage *pkg = procs[lo].e->pkg;
+		isize total_size = 0;
+		isize hi = lo;
+		while (hi < procs.count && procs[hi].e->pkg == pkg) {
+			total_size += procs[hi].size;
+			hi += 1;
+		}
+		isize first = lo;
+		lo = hi;
+
+		isize unit_count = gb_min(max_unit_count, total_size / LB_CODEGEN_UNIT_MINIMUM_SIZE);
+		if (unit_count <= 1) {
+			continue;
+		}
+
+		array_clear(&units);
+		array_clear(&unit_sizes);
+		array_add(&units, lb_pkg_module(gen, pkg));
+		array_add(&unit_sizes, cast(isize)0);
+		for (isize j = 1; j < unit_count; j++) {
+			auto m = gb_alloc_item(permanent_allocator(), lbModule);
+			m->pkg = pkg;
+			m->codegen_unit = j;
+			m->gen = gen;
+			map_set(&gen->modules, cast(void *)m, m);
+			lb_init_module(m, c);
+
+			array_add(&units, m);
+			array_add(&unit_sizes, cast(isize)0);
+		}
+
+		// NOTE: Largest procedures first, each into the currently smallest unit
+		for (isize i = first; i < hi; i++) {
+			isize smallest = 0;
+			for_array(j, unit_sizes) {
+				if (unit_sizes[j] < unit_sizes[smallest]) {
+					smallest = j;
+				}
+			}
+			unit_sizes[smallest] += procs[i].size;
+			if (smallest != 0) {
+				map_set(&gen->codegen_unit_modules, procs[i].e, units[smallest]);
+			}
+		}
+	}
 }
 
 bool lb_init_generator(lbGenerator *gen, Checker *c) {
@@ -122,6 +262,8 @@ bool lb_init_generator(lbGenerator *gen, Checker *c) {
 
 	map_init(&gen->modules, permanent_allocator(), gen->info->packages.entries.count*2);
 	map_init(&gen->modules_through_ctx, permanent_allocator(), gen->info->packages.entries.count*2);
+	map_init(&gen->codegen_unit_modules, heap_allocator());
+	mutex_init(&gen->anonymous_proc_lits_mutex);
 	map_init(&gen->anonymous_proc_lits, heap_allocator(), 1024);
 
 
@@ -129,6 +271,11 @@ bool lb_init_generator(lbGenerator *gen, Checker *c) {
 	array_init(&gen->foreign_libraries,       heap_allocator(), 0, 1024);
 	ptr_set_init(&gen->foreign_libraries_set, heap_allocator(), 1024);
 
+	mutex_init(&lb_entity_name_mutex);
+	mutex_init(&gen->default_module_mutex);
+	mutex_init(&gen->linkage_mutex);
+	array_init(&gen->pending_external_linkages, heap_allocator(), 0, 1024);
+
 	if (USE_SEPARATE_MODULES) {
 		for_array(i, gen->info->packages.entries) {
 			AstPackage *pkg = gen->info->packages.entries[i].value;
@@ -136,13 +283,15 @@ bool lb_init_generator(lbGenerator *gen, Checker *c) {
 			auto m = gb_alloc_item(permanent_allocator(), lbModule);
 			m->pkg = pkg;
 			m->gen = gen;
-			map_set(&gen->modules, pkg, m);
+			map_set(&gen->modules, cast(void *)pkg, m);
 			lb_init_module(m, c);
 		}
+
+		lb_init_codegen_units(gen, c);
 	}
 
 	gen->default_module.gen = gen;
-	map_set(&gen->modules, cast(AstPackage *)nullptr, &gen->default_module);
+	map_set(&gen->modules, cast(void *)nullptr, &gen->default_module);
 	lb_init_module(&gen->default_module, c);
 
 
@@ -265,13 +414,22 @@ bool lb_is_instr_terminating(LLVMValueRef instr) {
 
 
 lbModule *lb_pkg_module(lbGenerator *gen, AstPackage *pkg) {
-	auto *found = map_get(&gen->modules, pkg);
+	auto *found = map_get(&gen->modules, cast(void *)pkg);
 	if (found) {
 		return *found;
 	}
 	return &gen->default_module;
 }
 
+// NOTE: The module which defines the entity, which may be one of the extra codegen units of its package
+lbModule *lb_entity_module(lbGenerator *gen, Entity *e) {
+	auto *found = map_get(&gen->codegen_unit_modules, e);
+	if (found) {
+		return *found;
+	}
+	return lb_pkg_module(gen, e->pkg);
+}
+
 
 lbAddr lb_addr(lbValue addr) {
 	lbAddr v = {lbAddr_Default, addr};
@@ -1246,6 +1404,8 @@ void lb_emit_store_union_variant(lbProcedure *p, lbValue parent, lbValue variant
 
 
 void lb_clone_struct_type(LLVMTypeRef dst, LLVMTypeRef src) {
+	TEMPORARY_ALLOCATOR_GUARD();
+
 	unsigned field_count = LLVMCountStructElementTypes(src);
 	LLVMTypeRef *fields = gb_alloc_array(temporary_allocator(), LLVMTypeRef, field_count);
 	LLVMGetStructElementTypes(src, fields);
@@ -1365,50 +1525,67 @@ String lb_set_nested_type_name_ir_mangled_name(Entity *e, lbProcedure *p) {
 	}
 }
 
-String lb_get_entity_name(lbModule *m, Entity *e, String default_name) {
-	if (e != nullptr && e->kind == Entity_TypeName && e->TypeName.ir_mangled_name.len != 0) {
+String lb_get_cached_entity_name(Entity *e) {
+	if (e->kind == Entity_TypeName) {
 		return e->TypeName.ir_mangled_name;
+	} else if (e->kind == Entity_Procedure) {
+		return e->Procedure.link_name;
 	}
+	return {};
+}
+
+String lb_get_entity_name(lbModule *m, Entity *e, String default_name) {
 	GB_ASSERT(e != nullptr);
 
 	if (e->pkg == nullptr) {
 		return e->token.string;
 	}
 
-	if (e->kind == Entity_TypeName && (e->scope->flags & ScopeFlag_File) == 0) {
-		return lb_set_nested_type_name_ir_mangled_name(e, nullptr);
-	}
-
-	String name = {};
-
-	bool no_name_mangle = false;
-
 	if (e->kind == Entity_Variable) {
-		bool is_foreign = e->Variable.is_foreign;
-		bool is_export  = e->Variable.is_export;
-		no_name_mangle = e->Variable.link_name.len > 0 || is_foreign || is_export;
+		// NOTE: variable names are only ever written by the checker
 		if (e->Variable.link_name.len > 0) {
 			return e->Variable.link_name;
 		}
-	} else if (e->kind == Entity_Procedure && e->Procedure.link_name.len > 0) {
-		return e->Procedure.link_name;
-	} else if (e->kind == Entity_Procedure && e->Procedure.is_export) {
-		no_name_mangle = true;
+		bool no_name_mangle = e->Variable.is_foreign || e->Variable.is_export;
+		String name = {};
+		if (!no_name_mangle) {
+			name = lb_mangle_name(m, e);
+		}
+		if (name.len == 0) {
+			name = e->token.string;
+		}
+		return name;
 	}
 
-	if (!no_name_mangle) {
-		name = lb_mangle_name(m, e);
+	if (e->flags.load(std::memory_order_acquire) & EntityFlag_CodeGenName) {
+		return lb_get_cached_entity_name(e);
 	}
+
+	mutex_lock(&lb_entity_name_mutex);
+	defer (mutex_unlock(&lb_entity_name_mutex));
+
+	String name = lb_get_cached_entity_name(e);
 	if (name.len == 0) {
-		name = e->token.string;
-	}
+		if (e->kind == Entity_TypeName && (e->scope->flags & ScopeFlag_File) == 0) {
+			name = lb_set_nested_type_name_ir_mangled_name(e, nullptr);
+		} else {
+			if (!(e->kind == Entity_Procedure && e->Procedure.is_export)) {
+				name = lb_mangle_name(m, e);
+			}
+			if (name.len == 0) {
+				name = e->token.string;
+			}
 
-	if (e->kind == Entity_TypeName) {
-		e->TypeName.ir_mangled_name = name;
-	} else if (e->kind == Entity_Procedure) {
-		e->Procedure.link_name = name;
+			if (e->kind == Entity_TypeName) {
+				e->TypeName.ir_mangled_name = name;
+			} else if (e->kind == Entity_Procedure) {
+				e->Procedure.link_name = name;
+			}
+		}
+	}
+	if (e->kind == Entity_TypeName || e->kind == Entity_Procedure) {
+		e->flags.fetch_or(EntityFlag_CodeGenName, std::memory_order_release);
 	}
-
 	return name;
 }
 
@@ -2458,7 +2635,7 @@ lbValue lb_find_ident(lbProcedure *p, lbModule *m, Entity *e, Ast *expr) {
 		return lb_find_procedure_value_from_entity(m, e);
 	}
 	if (USE_SEPARATE_MODULES) {
-		lbModule *other_module = lb_pkg_module(m->gen, e->pkg);
+		lbModule *other_module = lb_entity_module(m->gen, e);
 		if (other_module != m) {
 
 			String name = lb_get_entity_name(other_module, e);
@@ -2500,7 +2677,7 @@ lbValue lb_find_procedure_value_from_entity(lbModule *m, Entity *e) {
 
 	lbModule *other_module = m;
 	if (USE_SEPARATE_MODULES) {
-		other_module = lb_pkg_module(m->gen, e->pkg);
+		other_module = lb_entity_module(m->gen, e);
 	}
 	if (other_module == m) {
 		debugf("Missing Procedure (lb_find_procedure_value_from_entity): %.*s\n", LIT(e->token.string));
@@ -2584,7 +2761,7 @@ lbValue lb_find_value_from_entity(lbModule *m, Entity *e) {
 	}
 
 	if (USE_SEPARATE_MODULES) {
-		lbModule *other_module = lb_pkg_module(m->gen, e->pkg);
+		lbModule *other_module = lb_entity_module(m->gen, e);
 
 		// TODO(bill): correct this logic
 		bool is_external = other_module != m;
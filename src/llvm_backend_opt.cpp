@@ -381,6 +381,8 @@ void llvm_delete_function(LLVMValueRef func) {
 }
 
 void lb_append_to_compiler_used(lbModule *m, LLVMValueRef func) {
+	TEMPORARY_ALLOCATOR_GUARD();
+
 	LLVMValueRef global = LLVMGetNamedGlobal(m->mod, "llvm.compiler.used");
 
 	LLVMValueRef *constants;
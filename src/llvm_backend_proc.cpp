@@ -68,7 +68,7 @@ lbProcedure *lb_create_procedure(lbModule *m, Entity *entity, bool ignore_body)
 	String link_name = {};
 
 	if (ignore_body) {
-		lbModule *other_module = lb_pkg_module(m->gen, entity->pkg);
+		lbModule *other_module = lb_entity_module(m->gen, entity);
 		link_name = lb_get_entity_name(other_module, entity);
 	} else {
 		link_name = lb_get_entity_name(m, entity);
@@ -87,8 +87,12 @@ lbProcedure *lb_create_procedure(lbModule *m, Entity *entity, bool ignore_body)
 	lbProcedure *p = gb_alloc_item(permanent_allocator(), lbProcedure);
 
 	p->module = m;
-	entity->code_gen_module = m;
-	entity->code_gen_procedure = p;
+	if (!ignore_body) {
+		mutex_lock(&lb_entity_name_mutex);
+		entity->code_gen_module = m;
+		entity->code_gen_procedure = p;
+		mutex_unlock(&lb_entity_name_mutex);
+	}
 	p->entity = entity;
 	p->name = link_name;
 
@@ -200,24 +204,22 @@ lbProcedure *lb_create_procedure(lbModule *m, Entity *entity, bool ignore_body)
 
 		lb_set_wasm_export_attributes(p->value, p->name);
 	} else if (!p->is_foreign) {
-		if (!USE_SEPARATE_MODULES) {
-			LLVMSetLinkage(p->value, LLVMInternalLinkage);
-
-			// NOTE(bill): if a procedure is defined in package runtime and uses a custom link name,
-			// then it is very likely it is required by LLVM and thus cannot have internal linkage
-			if (entity->pkg != nullptr && entity->pkg->kind == Package_Runtime && p->body != nullptr) {
-				GB_ASSERT(entity->kind == Entity_Procedure);
-				String link_name = entity->Procedure.link_name;
-				if (entity->flags & EntityFlag_CustomLinkName && 
-					link_name != "") {
-					if (string_starts_with(link_name, str_lit("__"))) {
-						LLVMSetLinkage(p->value, LLVMExternalLinkage);
-					} else {
-						LLVMSetLinkage(p->value, LLVMInternalLinkage);
-					}
-				}
+		// NOTE(bill): if a procedure is defined in package runtime and uses a custom link name,
+		// then it is very likely it is required by LLVM and thus cannot have internal linkage
+		bool required_by_llvm = false;
+		if (entity->pkg != nullptr && entity->pkg->kind == Package_Runtime && p->body != nullptr) {
+			String link_name = entity->Procedure.link_name;
+			if (entity->flags & EntityFlag_CustomLinkName &&
+			    string_starts_with(link_name, str_lit("__"))) {
+				required_by_llvm = true;
 			}
 		}
+
+		if (!USE_SEPARATE_MODULES) {
+			LLVMSetLinkage(p->value, required_by_llvm ? LLVMExternalLinkage : LLVMInternalLinkage);
+		} else if (!required_by_llvm && !ignore_body) {
+			lb_add_lto_internal_name(m, entity, p->name);
+		}
 	}
 	lb_set_linkage_from_entity_flags(p->module, p->value, entity->flags);
 
@@ -653,9 +655,8 @@ void lb_end_procedure(lbProcedure *p) {
 void lb_build_nested_proc(lbProcedure *p, AstProcLit *pd, Entity *e) {
 	GB_ASSERT(pd->body != nullptr);
 	lbModule *m = p->module;
-	auto *min_dep_set = &m->info->minimum_dependency_set;
 
-	if (ptr_set_exists(min_dep_set, e) == false) {
+	if (is_entity_a_minimum_dependency(e) == false) {
 		// NOTE(bill): Nothing depends upon it so doesn't need to be built
 		return;
 	}
@@ -1024,6 +1025,8 @@ lbValue lb_emit_call(lbProcedure *p, lbValue value, Array<lbValue> const &args,
 }
 
 LLVMValueRef llvm_splat_float(i64 count, LLVMTypeRef type, f64 value) {
+	TEMPORARY_ALLOCATOR_GUARD();
+
 	LLVMValueRef v = LLVMConstReal(type, value);
 	LLVMValueRef *values = gb_alloc_array(temporary_allocator(), LLVMValueRef, count);
 	for (i64 i = 0; i < count; i++) {
@@ -1032,6 +1035,8 @@ LLVMValueRef llvm_splat_float(i64 count, LLVMTypeRef type, f64 value) {
 	return LLVMConstVector(values, cast(unsigned)count);
 }
 LLVMValueRef llvm_splat_int(i64 count, LLVMTypeRef type, i64 value, bool is_signed=false) {
+	TEMPORARY_ALLOCATOR_GUARD();
+
 	LLVMValueRef v = LLVMConstInt(type, value, is_signed);
 	LLVMValueRef *values = gb_alloc_array(temporary_allocator(), LLVMValueRef, count);
 	for (i64 i = 0; i < count; i++) {
@@ -1396,7 +1401,7 @@ lbValue lb_build_builtin_simd_proc(lbProcedure *p, Ast *expr, TypeAndValue const
 			BigInt bi_count = {};
 			big_int_from_i64(&bi_count, count);
 
-			TypeAndValue const &tv = ce->args[1]->tav;
+			TypeAndValue const &tv = ce->args[1]->tav();
 			ExactValue val = exact_value_to_integer(tv.value);
 			GB_ASSERT(val.kind == ExactValue_Integer);
 			BigInt *bi = &val.value_integer;
@@ -2313,10 +2318,10 @@ lbValue lb_build_builtin_proc(lbProcedure *p, Ast *expr, TypeAndValue const &tv,
 
 
 	case BuiltinProc_type_equal_proc:
-		return lb_get_equal_proc_for_type(p->module, ce->args[0]->tav.type);
+		return lb_get_equal_proc_for_type(p->module, ce->args[0]->tav().type);
 
 	case BuiltinProc_type_hasher_proc:
-		return lb_get_hasher_proc_for_type(p->module, ce->args[0]->tav.type);
+		return lb_get_hasher_proc_for_type(p->module, ce->args[0]->tav().type);
 
 	case BuiltinProc_fixed_point_mul:
 	case BuiltinProc_fixed_point_div:
@@ -2394,7 +2399,7 @@ lbValue lb_build_builtin_proc(lbProcedure *p, Ast *expr, TypeAndValue const &tv,
 	case BuiltinProc_prefetch_write_data:
 		{
 			lbValue ptr = lb_emit_conv(p, lb_build_expr(p, ce->args[0]), t_rawptr);
-			unsigned long long locality = cast(unsigned long long)exact_value_to_i64(ce->args[1]->tav.value);
+			unsigned long long locality = cast(unsigned long long)exact_value_to_i64(ce->args[1]->tav().value);
 			unsigned long long rw = 0;
 			unsigned long long cache = 0;
 			switch (id) {
@@ -2915,8 +2920,8 @@ lbValue lb_build_call_expr_internal(lbProcedure *p, Ast *expr) {
 		}
 	}
 
-	if (proc_expr->tav.mode == Addressing_Constant) {
-		ExactValue v = proc_expr->tav.value;
+	if (proc_expr->tav().mode == Addressing_Constant) {
+		ExactValue v = proc_expr->tav().value;
 		switch (v.kind) {
 		case ExactValue_Integer:
 			{
@@ -2925,7 +2930,7 @@ lbValue lb_build_call_expr_internal(lbProcedure *p, Ast *expr) {
 				x.value = LLVMConstInt(lb_type(m, t_uintptr), u, false);
 				x.type = t_uintptr;
 				x = lb_emit_conv(p, x, t_rawptr);
-				value = lb_emit_conv(p, x, proc_expr->tav.type);
+				value = lb_emit_conv(p, x, proc_expr->tav().type);
 				break;
 			}
 		case ExactValue_Pointer:
@@ -2935,7 +2940,7 @@ lbValue lb_build_call_expr_internal(lbProcedure *p, Ast *expr) {
 				x.value = LLVMConstInt(lb_type(m, t_uintptr), u, false);
 				x.type = t_uintptr;
 				x = lb_emit_conv(p, x, t_rawptr);
-				value = lb_emit_conv(p, x, proc_expr->tav.type);
+				value = lb_emit_conv(p, x, proc_expr->tav().type);
 				break;
 			}
 		}
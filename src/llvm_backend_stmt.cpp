@@ -31,8 +31,6 @@ void lb_build_constant_value_decl(lbProcedure *p, AstValueDecl *vd) {
 		return;
 	}
 
-	auto *min_dep_set = &p->module->info->minimum_dependency_set;
-
 	static i32 global_guid = 0;
 
 	for_array(i, vd->names) {
@@ -52,7 +50,7 @@ void lb_build_constant_value_decl(lbProcedure *p, AstValueDecl *vd) {
 			}
 		}
 
-		if (!polymorphic_struct && !ptr_set_exists(min_dep_set, e)) {
+		if (!polymorphic_struct && !is_entity_a_minimum_dependency(e)) {
 			continue;
 		}
 
@@ -61,7 +59,9 @@ void lb_build_constant_value_decl(lbProcedure *p, AstValueDecl *vd) {
 			continue;
 		}
 
+		mutex_lock(&lb_entity_name_mutex);
 		lb_set_nested_type_name_ir_mangled_name(e, p);
+		mutex_unlock(&lb_entity_name_mutex);
 	}
 
 	for_array(i, vd->names) {
@@ -88,7 +88,7 @@ void lb_build_constant_value_decl(lbProcedure *p, AstValueDecl *vd) {
 				auto procs = *found;
 				for_array(i, procs) {
 					Entity *e = procs[i];
-					if (!ptr_set_exists(min_dep_set, e)) {
+					if (!is_entity_a_minimum_dependency(e)) {
 						continue;
 					}
 					DeclInfo *d = decl_info_of_entity(e);
@@ -405,6 +405,11 @@ void lb_build_range_string(lbProcedure *p, lbValue expr, Type *val_type,
 	lbAddr offset_ = lb_add_local_generated(p, t_int, false);
 	lb_addr_store(p, offset_, lb_const_int(m, t_int, 0));
 
+	lbAddr rune_ = {};
+	if (val_type != nullptr) {
+		rune_ = lb_add_local_generated(p, t_rune, false);
+	}
+
 	loop = lb_create_block(p, "for.string.loop");
 	lb_emit_jump(p, loop);
 	lb_start_block(p, loop);
@@ -420,18 +425,41 @@ void lb_build_range_string(lbProcedure *p, lbValue expr, Type *val_type,
 	lb_start_block(p, body);
 
 
+	// NOTE: ASCII bytes are their own rune and are always 1 byte long,
+	// so only call the decoder for the multibyte case
+	lbBlock *ascii_block  = lb_create_block(p, "for.string.ascii");
+	lbBlock *decode_block = lb_create_block(p, "for.string.decode");
+	lbBlock *next_block   = lb_create_block(p, "for.string.next");
+
 	lbValue str_elem = lb_emit_ptr_offset(p, lb_string_elem(p, expr), offset);
+	lbValue first_byte = lb_emit_load(p, str_elem);
+	lbValue is_ascii = lb_emit_comp(p, Token_Lt, first_byte, lb_const_int(m, t_u8, 0x80));
+	lb_emit_if(p, is_ascii, ascii_block, decode_block);
+
+	lb_start_block(p, ascii_block);
+	lb_addr_store(p, offset_, lb_emit_arith(p, Token_Add, offset, lb_const_int(m, t_int, 1), t_int));
+	if (val_type != nullptr) {
+		lb_addr_store(p, rune_, lb_emit_conv(p, first_byte, t_rune));
+	}
+	lb_emit_jump(p, next_block);
+
+	lb_start_block(p, decode_block);
 	lbValue str_len  = lb_emit_arith(p, Token_Sub, count, offset, t_int);
 	auto args = array_make<lbValue>(permanent_allocator(), 1);
 	args[0] = lb_emit_string(p, str_elem, str_len);
 	lbValue rune_and_len = lb_emit_runtime_call(p, "string_decode_rune", args);
 	lbValue len  = lb_emit_struct_ev(p, rune_and_len, 1);
 	lb_addr_store(p, offset_, lb_emit_arith(p, Token_Add, offset, len, t_int));
+	if (val_type != nullptr) {
+		lb_addr_store(p, rune_, lb_emit_struct_ev(p, rune_and_len, 0));
+	}
+	lb_emit_jump(p, next_block);
 
+	lb_start_block(p, next_block);
 
 	idx = offset;
 	if (val_type != nullptr) {
-		val = lb_emit_struct_ev(p, rune_and_len, 0);
+		val = lb_addr_load(p, rune_);
 	}
 
 	if (val_)  *val_  = val;
@@ -876,11 +904,11 @@ void lb_build_unroll_range_stmt(lbProcedure *p, AstUnrollRangeStmt *rs, Scope *s
 		TokenKind op = expr->BinaryExpr.op.kind;
 		Ast *start_expr = expr->BinaryExpr.left;
 		Ast *end_expr   = expr->BinaryExpr.right;
-		GB_ASSERT(start_expr->tav.mode == Addressing_Constant);
-		GB_ASSERT(end_expr->tav.mode == Addressing_Constant);
+		GB_ASSERT(start_expr->tav().mode == Addressing_Constant);
+		GB_ASSERT(end_expr->tav().mode == Addressing_Constant);
 
-		ExactValue start = start_expr->tav.value;
-		ExactValue end   = end_expr->tav.value;
+		ExactValue start = start_expr->tav().value;
+		ExactValue end   = end_expr->tav().value;
 		if (op != Token_RangeHalf) { // .. [start, end] (or ..=)
 			ExactValue index = exact_value_i64(0);
 			for (ExactValue val = start;
@@ -930,16 +958,16 @@ void lb_build_unroll_range_stmt(lbProcedure *p, AstUnrollRangeStmt *rs, Scope *s
 		if (val0_type) val0_addr = lb_build_addr(p, rs->val0);
 		if (val1_type) val1_addr = lb_build_addr(p, rs->val1);
 
-		GB_ASSERT(expr->tav.mode == Addressing_Constant);
+		GB_ASSERT(expr->tav().mode == Addressing_Constant);
 
-		Type *t = base_type(expr->tav.type);
+		Type *t = base_type(expr->tav().type);
 
 
 		switch (t->kind) {
 		case Type_Basic:
 			GB_ASSERT(is_type_string(t));
 			{
-				ExactValue value = expr->tav.value;
+				ExactValue value = expr->tav().value;
 				GB_ASSERT(value.kind == ExactValue_String);
 				String str = value.value_string;
 				Rune codepoint = 0;
@@ -1033,7 +1061,7 @@ bool lb_switch_stmt_can_be_trivial_jump_table(AstSwitchStmt *ss, bool *default_f
 			if (is_ast_range(expr)) {
 				return false;
 			}
-			if (expr->tav.mode == Addressing_Type) {
+			if (expr->tav().mode == Addressing_Type) {
 				GB_ASSERT(is_typeid);
 				continue;
 			}
@@ -1052,6 +1080,150 @@ bool lb_switch_stmt_can_be_trivial_jump_table(AstSwitchStmt *ss, bool *default_f
 }
 
 
+// NOTE: A `switch` on a string where every case is a constant string can be dispatched on the
+// length of the tag and then on a byte which distinguishes the cases, followed by a single comparison
+bool lb_switch_stmt_can_be_string_dispatch(AstSwitchStmt *ss) {
+	if (ss->tag == nullptr) {
+		return false;
+	}
+	Type *tag_type = type_of_expr(ss->tag);
+	if (!is_type_string(tag_type) || is_type_cstring(tag_type) || is_type_untyped(tag_type)) {
+		return false;
+	}
+
+	isize case_count = 0;
+	ast_node(body, BlockStmt, ss->body);
+	for_array(i, body->stmts) {
+		ast_node(cc, CaseClause, body->stmts[i]);
+		for_array(j, cc->list) {
+			Ast *expr = unparen_expr(cc->list[j]);
+			if (is_ast_range(expr)) {
+				return false;
+			}
+			TypeAndValue tv = type_and_value_of_expr(expr);
+			if (tv.mode != Addressing_Constant || tv.value.kind != ExactValue_String) {
+				return false;
+			}
+			case_count += 1;
+		}
+	}
+	return case_count > 0;
+}
+
+struct lbStringSwitchCase {
+	String   value;
+	lbBlock *body;
+};
+
+GB_COMPARE_PROC(lb_string_switch_case_cmp) {
+	lbStringSwitchCase const *x = cast(lbStringSwitchCase const *)a;
+	lbStringSwitchCase const *y = cast(lbStringSwitchCase const *)b;
+	if (x->value.len != y->value.len) {
+		return x->value.len < y->value.len ? -1 : +1;
+	}
+	return string_compare(x->value, y->value);
+}
+
+void lb_emit_string_switch_confirm(lbProcedure *p, lbValue tag_data, lbStringSwitchCase const &c, lbBlock *default_block) {
+	lbModule *m = p->module;
+	if (c.value.len == 0) {
+		lb_emit_jump(p, c.body);
+		return;
+	}
+	lbValue value_data = lb_string_elem(p, lb_const_string(m, c.value));
+
+	lbValue cond = {};
+	if (c.value.len <= LB_INLINE_MEMORY_COMPARE_MAX_SIZE) {
+		cond = lb_emit_memory_equal_inline(p, tag_data, value_data, c.value.len);
+	} else {
+		auto args = array_make<lbValue>(permanent_allocator(), 3);
+		args[0] = lb_emit_conv(p, tag_data, t_rawptr);
+		args[1] = lb_emit_conv(p, value_data, t_rawptr);
+		args[2] = lb_const_int(m, t_int, c.value.len);
+		cond = lb_emit_runtime_call(p, "memory_equal", args);
+	}
+	lb_emit_if(p, cond, c.body, default_block);
+}
+
+// NOTE: Jumps to the body of the case matching `tag`, or to `default_block`.
+// This replaces a chain of `string_eq` calls, one per case, with a `switch` on the length of the tag,
+// then a `switch` on a byte position which differs between all the cases of that length (if there is
+// one), and finally a single comparison to confirm the match.
+void lb_emit_string_switch_dispatch(lbProcedure *p, lbValue tag, Slice<lbStringSwitchCase> cases, lbBlock *default_block) {
+	lbModule *m = p->module;
+	gb_sort_array(cases.data, cases.count, lb_string_switch_case_cmp);
+
+	lbValue tag_len  = lb_string_len(p, tag);
+	lbValue tag_data = lb_string_elem(p, tag);
+
+	unsigned length_count = 0;
+	for_array(i, cases) {
+		if (i == 0 || cases[i].value.len != cases[i-1].value.len) {
+			length_count += 1;
+		}
+	}
+	LLVMValueRef len_switch = LLVMBuildSwitch(p->builder, tag_len.value, default_block->block, length_count);
+
+	for (isize lo = 0; lo < cases.count; /**/) {
+		isize len = cases[lo].value.len;
+		isize hi = lo+1;
+		while (hi < cases.count && cases[hi].value.len == len) {
+			hi += 1;
+		}
+		auto group = slice(cases, lo, hi);
+		lo = hi;
+
+		lbBlock *len_block = lb_create_block(p, "switch.string.len");
+		LLVMAddCase(len_switch, lb_const_int(m, t_int, len).value, len_block->block);
+		lb_start_block(p, len_block);
+
+		if (group.count == 1) {
+			lb_emit_string_switch_confirm(p, tag_data, group[0], default_block);
+			continue;
+		}
+
+		isize byte_index = -1;
+		for (isize k = 0; k < len && byte_index < 0; k++) {
+			bool seen[256] = {};
+			bool distinct = true;
+			for_array(j, group) {
+				u8 b = group[j].value[k];
+				if (seen[b]) {
+					distinct = false;
+					break;
+				}
+				seen[b] = true;
+			}
+			if (distinct) {
+				byte_index = k;
+			}
+		}
+
+		if (byte_index >= 0) {
+			lbValue b = lb_emit_load(p, lb_emit_ptr_offset(p, tag_data, lb_const_int(m, t_int, byte_index)));
+			LLVMValueRef byte_switch = LLVMBuildSwitch(p->builder, b.value, default_block->block, cast(unsigned)group.count);
+			for_array(j, group) {
+				lbBlock *byte_block = lb_create_block(p, "switch.string.byte");
+				LLVMAddCase(byte_switch, lb_const_int(m, t_u8, group[j].value[byte_index]).value, byte_block->block);
+				lb_start_block(p, byte_block);
+				lb_emit_string_switch_confirm(p, tag_data, group[j], default_block);
+			}
+		} else {
+			for_array(j, group) {
+				lbBlock *next = default_block;
+				if (j+1 < group.count) {
+					next = lb_create_block(p, "switch.string.next");
+				}
+				lb_emit_string_switch_confirm(p, tag_data, group[j], next);
+				if (j+1 < group.count) {
+					lb_start_block(p, next);
+				}
+			}
+		}
+	}
+}
+
+
 void lb_build_switch_stmt(lbProcedure *p, AstSwitchStmt *ss, Scope *scope) {
 	lb_open_scope(p, scope);
 
@@ -1074,6 +1246,7 @@ void lb_build_switch_stmt(lbProcedure *p, AstSwitchStmt *ss, Scope *scope) {
 
 	bool default_found = false;
 	bool is_trivial = lb_switch_stmt_can_be_trivial_jump_table(ss, &default_found);
+	bool is_string_dispatch = !is_trivial && lb_switch_stmt_can_be_string_dispatch(ss);
 
 	auto body_blocks = slice_make<lbBlock *>(permanent_allocator(), body->stmts.count);
 	for_array(i, body->stmts) {
@@ -1102,7 +1275,32 @@ void lb_build_switch_stmt(lbProcedure *p, AstSwitchStmt *ss, Scope *scope) {
 		}
 
 		switch_instr = LLVMBuildSwitch(p->builder, tag.value, end_block, cast(unsigned)num_cases);
+	} else if (is_string_dispatch) {
+		isize num_cases = 0;
+		for_array(i, body->stmts) {
+			ast_node(cc, CaseClause, body->stmts[i]);
+			num_cases += cc->list.count;
+		}
+
+		auto cases = slice_make<lbStringSwitchCase>(permanent_allocator(), num_cases);
+		isize case_index = 0;
+		for_array(i, body->stmts) {
+			ast_node(cc, CaseClause, body->stmts[i]);
+			for_array(j, cc->list) {
+				Ast *expr = unparen_expr(cc->list[j]);
+				cases[case_index].value = type_and_value_of_expr(expr).value.value_string;
+				cases[case_index].body  = body_blocks[i];
+				case_index += 1;
+			}
+		}
+
+		lbBlock *end_block = done;
+		if (default_block) {
+			end_block = default_block;
+		}
+		lb_emit_string_switch_dispatch(p, tag, cases, end_block);
 	}
+	bool is_dispatched = switch_instr != nullptr || is_string_dispatch;
 
 
 	for_array(i, body->stmts) {
@@ -1119,7 +1317,7 @@ void lb_build_switch_stmt(lbProcedure *p, AstSwitchStmt *ss, Scope *scope) {
 			// default case
 			default_stmts = cc->stmts;
 			default_fall  = fall;
-			if (switch_instr == nullptr) {
+			if (!is_dispatched) {
 				default_block = body;
 			} else {
 				GB_ASSERT(default_block != nullptr);
@@ -1133,12 +1331,12 @@ void lb_build_switch_stmt(lbProcedure *p, AstSwitchStmt *ss, Scope *scope) {
 
 			if (switch_instr != nullptr) {
 				lbValue on_val = {};
-				if (expr->tav.mode == Addressing_Type) {
+				if (expr->tav().mode == Addressing_Type) {
 					GB_ASSERT(is_type_typeid(tag.type));
-					lbValue e = lb_typeid(p->module, expr->tav.type);
+					lbValue e = lb_typeid(p->module, expr->tav().type);
 					on_val = lb_emit_conv(p, e, tag.type);
 				} else {
-					GB_ASSERT(expr->tav.mode == Addressing_Constant);
+					GB_ASSERT(expr->tav().mode == Addressing_Constant);
 					GB_ASSERT(!is_ast_range(expr));
 
 					on_val = lb_build_expr(p, expr);
@@ -1149,6 +1347,9 @@ void lb_build_switch_stmt(lbProcedure *p, AstSwitchStmt *ss, Scope *scope) {
 				LLVMAddCase(switch_instr, on_val.value, body->block);
 				continue;
 			}
+			if (is_string_dispatch) {
+				continue;
+			}
 
 			next_cond = lb_create_block(p, "switch.case.next");
 
@@ -1169,9 +1370,9 @@ void lb_build_switch_stmt(lbProcedure *p, AstSwitchStmt *ss, Scope *scope) {
 				lbValue cond_rhs = lb_emit_comp(p, op, tag, rhs);
 				cond = lb_emit_arith(p, Token_And, cond_lhs, cond_rhs, t_bool);
 			} else {
-				if (expr->tav.mode == Addressing_Type) {
+				if (expr->tav().mode == Addressing_Type) {
 					GB_ASSERT(is_type_typeid(tag.type));
-					lbValue e = lb_typeid(p->module, expr->tav.type);
+					lbValue e = lb_typeid(p->module, expr->tav().type);
 					e = lb_emit_conv(p, e, tag.type);
 					cond = lb_emit_comp(p, Token_CmpEq, tag, e);
 				} else {
@@ -1191,13 +1392,13 @@ void lb_build_switch_stmt(lbProcedure *p, AstSwitchStmt *ss, Scope *scope) {
 		lb_pop_target_list(p);
 
 		lb_emit_jump(p, done);
-		if (switch_instr == nullptr) {
+		if (!is_dispatched) {
 			lb_start_block(p, next_cond);
 		}
 	}
 
 	if (default_block != nullptr) {
-		if (switch_instr == nullptr) {
+		if (!is_dispatched) {
 			lb_emit_jump(p, default_block);
 		}
 		lb_start_block(p, default_block);
@@ -1389,11 +1590,11 @@ void lb_build_static_variables(lbProcedure *p, AstValueDecl *vd) {
 		if (vd->values.count > 0) {
 			GB_ASSERT(vd->names.count == vd->values.count);
 			Ast *ast_value = vd->values[i];
-			GB_ASSERT(ast_value->tav.mode == Addressing_Constant ||
-			          ast_value->tav.mode == Addressing_Invalid);
+			GB_ASSERT(ast_value->tav().mode == Addressing_Constant ||
+			          ast_value->tav().mode == Addressing_Invalid);
 
 			bool allow_local = false;
-			value = lb_const_value(p->module, ast_value->tav.type, ast_value->tav.value, allow_local);
+			value = lb_const_value(p->module, ast_value->tav().type, ast_value->tav().value, allow_local);
 		}
 
 		Ast *ident = vd->names[i];
@@ -1948,7 +2149,7 @@ void lb_build_assign_stmt(lbProcedure *p, AstAssignStmt *as) {
 	op_ += Token_Add - Token_AddEq; // Convert += to +
 	TokenKind op = cast(TokenKind)op_;
 	if (op == Token_CmpAnd || op == Token_CmpOr) {
-		Type *type = as->lhs[0]->tav.type;
+		Type *type = as->lhs[0]->tav().type;
 		lbValue new_value = lb_emit_logical_binary_expr(p, op, as->lhs[0], as->rhs[0], type);
 
 		lbAddr lhs = lb_build_addr(p, as->lhs[0]);
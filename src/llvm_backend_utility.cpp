@@ -1887,6 +1887,7 @@ lbAddr lb_handle_objc_find_or_register_selector(lbProcedure *p, String const &na
 		return *found;
 	} else {
 		lbModule *default_module = &p->module->gen->default_module;
+		mutex_lock(&p->module->gen->default_module_mutex);
 		Entity *e = nullptr;
 		lbAddr default_addr = lb_add_global_generated(default_module, t_objc_SEL, {}, &e);
 
@@ -1894,6 +1895,7 @@ lbAddr lb_handle_objc_find_or_register_selector(lbProcedure *p, String const &na
 		lbAddr local_addr = lb_addr(ptr);
 
 		string_map_set(&default_module->objc_selectors, name, default_addr);
+		mutex_unlock(&p->module->gen->default_module_mutex);
 		if (default_module != p->module) {
 			string_map_set(&p->module->objc_selectors, name, local_addr);
 		}
@@ -1904,7 +1906,7 @@ lbAddr lb_handle_objc_find_or_register_selector(lbProcedure *p, String const &na
 lbValue lb_handle_objc_find_selector(lbProcedure *p, Ast *expr) {
 	ast_node(ce, CallExpr, expr);
 
-	auto tav = ce->args[0]->tav;
+	auto tav = ce->args[0]->tav();
 	GB_ASSERT(tav.value.kind == ExactValue_String);
 	String name = tav.value.value_string;
 	return lb_addr_load(p, lb_handle_objc_find_or_register_selector(p, name));
@@ -1914,7 +1916,7 @@ lbValue lb_handle_objc_register_selector(lbProcedure *p, Ast *expr) {
 	ast_node(ce, CallExpr, expr);
 	lbModule *m = p->module;
 
-	auto tav = ce->args[0]->tav;
+	auto tav = ce->args[0]->tav();
 	GB_ASSERT(tav.value.kind == ExactValue_String);
 	String name = tav.value.value_string;
 	lbAddr dst = lb_handle_objc_find_or_register_selector(p, name);
@@ -1933,6 +1935,7 @@ lbAddr lb_handle_objc_find_or_register_class(lbProcedure *p, String const &name)
 		return *found;
 	} else {
 		lbModule *default_module = &p->module->gen->default_module;
+		mutex_lock(&p->module->gen->default_module_mutex);
 		Entity *e = nullptr;
 		lbAddr default_addr = lb_add_global_generated(default_module, t_objc_SEL, {}, &e);
 
@@ -1940,6 +1943,7 @@ lbAddr lb_handle_objc_find_or_register_class(lbProcedure *p, String const &name)
 		lbAddr local_addr = lb_addr(ptr);
 
 		string_map_set(&default_module->objc_classes, name, default_addr);
+		mutex_unlock(&p->module->gen->default_module_mutex);
 		if (default_module != p->module) {
 			string_map_set(&p->module->objc_classes, name, local_addr);
 		}
@@ -1950,7 +1954,7 @@ lbAddr lb_handle_objc_find_or_register_class(lbProcedure *p, String const &name)
 lbValue lb_handle_objc_find_class(lbProcedure *p, Ast *expr) {
 	ast_node(ce, CallExpr, expr);
 
-	auto tav = ce->args[0]->tav;
+	auto tav = ce->args[0]->tav();
 	GB_ASSERT(tav.value.kind == ExactValue_String);
 	String name = tav.value.value_string;
 	return lb_addr_load(p, lb_handle_objc_find_or_register_class(p, name));
@@ -1960,7 +1964,7 @@ lbValue lb_handle_objc_register_class(lbProcedure *p, Ast *expr) {
 	ast_node(ce, CallExpr, expr);
 	lbModule *m = p->module;
 
-	auto tav = ce->args[0]->tav;
+	auto tav = ce->args[0]->tav();
 	GB_ASSERT(tav.value.kind == ExactValue_String);
 	String name = tav.value.value_string;
 	lbAddr dst = lb_handle_objc_find_or_register_class(p, name);
@@ -1990,6 +1994,7 @@ lbValue lb_handle_objc_id(lbProcedure *p, Ast *expr) {
 			return lb_addr_load(p, *found);
 		} else {
 			lbModule *default_module = &p->module->gen->default_module;
+			mutex_lock(&p->module->gen->default_module_mutex);
 			Entity *e = nullptr;
 			lbAddr default_addr = lb_add_global_generated(default_module, t_objc_Class, {}, &e);
 
@@ -1997,6 +2002,7 @@ lbValue lb_handle_objc_id(lbProcedure *p, Ast *expr) {
 			lbAddr local_addr = lb_addr(ptr);
 
 			string_map_set(&default_module->objc_classes, name, default_addr);
+			mutex_unlock(&p->module->gen->default_module_mutex);
 			if (default_module != p->module) {
 				string_map_set(&p->module->objc_classes, name, local_addr);
 			}
@@ -2020,8 +2026,8 @@ lbValue lb_handle_objc_send(lbProcedure *p, Ast *expr) {
 
 	lbValue id = lb_handle_objc_id(p, ce->args[1]);
 	Ast *sel_expr = ce->args[2];
-	GB_ASSERT(sel_expr->tav.value.kind == ExactValue_String);
-	lbValue sel = lb_addr_load(p, lb_handle_objc_find_or_register_selector(p, sel_expr->tav.value.value_string));
+	GB_ASSERT(sel_expr->tav().value.kind == ExactValue_String);
+	lbValue sel = lb_addr_load(p, lb_handle_objc_find_or_register_selector(p, sel_expr->tav().value.value_string));
 
 	array_add(&args, id);
 	array_add(&args, sel);
@@ -620,8 +620,11 @@ enum BuildFlagKind {
 	BuildFlag_NoEntryPoint,
 	BuildFlag_UseLLD,
 	BuildFlag_UseSeparateModules,
+	BuildFlag_CodegenUnits,
+	BuildFlag_LTO,
 	BuildFlag_ThreadedChecker,
 	BuildFlag_NoThreadedChecker,
+	BuildFlag_MemoryMapSourceFiles,
 	BuildFlag_ShowDebugMessages,
 	BuildFlag_Vet,
 	BuildFlag_VetExtra,
@@ -781,8 +784,11 @@ bool parse_build_flags(Array<String> args) {
 	add_flag(&build_flags, BuildFlag_NoEntryPoint,            str_lit("no-entry-point"),            BuildFlagParam_None,    Command__does_check &~ Command_test);
 	add_flag(&build_flags, BuildFlag_UseLLD,                  str_lit("lld"),                       BuildFlagParam_None,    Command__does_build);
 	add_flag(&build_flags, BuildFlag_UseSeparateModules,      str_lit("use-separate-modules"),      BuildFlagParam_None,    Command__does_build);
+	add_flag(&build_flags, BuildFlag_CodegenUnits,            str_lit("codegen-units"),             BuildFlagParam_Integer, Command__does_build);
+	add_flag(&build_flags, BuildFlag_LTO,                     str_lit("lto"),                       BuildFlagParam_None,    Command__does_build);
 	add_flag(&build_flags, BuildFlag_ThreadedChecker,         str_lit("threaded-checker"),          BuildFlagParam_None,    Command__does_check);
 	add_flag(&build_flags, BuildFlag_NoThreadedChecker,       str_lit("no-threaded-checker"),       BuildFlagParam_None,    Command__does_check);
+	add_flag(&build_flags, BuildFlag_MemoryMapSourceFiles,    str_lit("memory-map-source-files"),   BuildFlagParam_None,    Command__does_check);
 	add_flag(&build_flags, BuildFlag_ShowDebugMessages,       str_lit("show-debug-messages"),       BuildFlagParam_None,    Command_all);
 	add_flag(&build_flags, BuildFlag_Vet,                     str_lit("vet"),                       BuildFlagParam_None,    Command__does_check);
 	add_flag(&build_flags, BuildFlag_VetExtra,                str_lit("vet-extra"),                 BuildFlagParam_None,    Command__does_check);
@@ -1332,6 +1338,21 @@ bool parse_build_flags(Array<String> args) {
 						case BuildFlag_UseSeparateModules:
 							build_context.use_separate_modules = true;
 							break;
+						case BuildFlag_CodegenUnits: {
+							GB_ASSERT(value.kind == ExactValue_Integer);
+							isize count = cast(isize)big_int_to_i64(&value.value_integer);
+							if (count <= 0) {
+								gb_printf_err("%.*s expected a positive non-zero number, got %.*s\n", LIT(name), LIT(param));
+								bad_flags = true;
+							} else {
+								build_context.codegen_units = count;
+							}
+							break;
+						}
+						case BuildFlag_LTO:
+							build_context.use_separate_modules = true;
+							build_context.lto = true;
+							break;
 						case BuildFlag_ThreadedChecker: {
 							#if defined(DEFAULT_TO_THREADED_CHECKER)
 							gb_printf_err("-threaded-checker is the default on this platform\n");
@@ -1348,6 +1369,9 @@ bool parse_build_flags(Array<String> args) {
 							build_context.threaded_checker = false;
 							break;
 						}
+						case BuildFlag_MemoryMapSourceFiles:
+							build_context.memory_map_source_files = true;
+							break;
 						case BuildFlag_ShowDebugMessages:
 							build_context.show_debug_messages = true;
 							break;
@@ -1783,6 +1807,27 @@ void show_timings(Checker *c, Timings *t) {
 
 	timings_print_all(t);
 
+	if (build_context.show_more_timings) {
+		u64 locks     = c->info.type_and_value_lock_count.load(std::memory_order_relaxed);
+		u64 contended = c->info.type_and_value_contended_count.load(std::memory_order_relaxed);
+		gb_printf("\n");
+		gb_printf("add_type_and_value locks     - %llu\n", cast(unsigned long long)locks);
+		gb_printf("add_type_and_value contended - %llu (%.3f%%)\n", cast(unsigned long long)contended, locks ? 100.0*cast(f64)contended/cast(f64)locks : 0.0);
+		gb_printf("AST node memory              - %.3f MiB\n", cast(f64)global_total_node_memory_allocated.load(std::memory_order_relaxed)/(1024.0*1024.0));
+		gb_printf("AST file node blocks         - %.3f MiB used of %.3f MiB, %td nodes overflowed\n",
+		          cast(f64)global_total_node_block_memory_used.load(std::memory_order_relaxed)/(1024.0*1024.0),
+		          cast(f64)global_total_node_block_memory_reserved.load(std::memory_order_relaxed)/(1024.0*1024.0),
+		          global_node_block_overflow_count.load(std::memory_order_relaxed));
+
+		StringInternTable *intern_table = string_intern_table.load(std::memory_order_acquire);
+		gb_printf("string_intern strings        - %td in %td slots, grown %td times in %.3f ms\n",
+		          intern_table->count.load(std::memory_order_relaxed),
+		          intern_table->capacity,
+		          string_intern_grow_count.load(std::memory_order_relaxed),
+		          1000.0*cast(f64)string_intern_grow_time.load(std::memory_order_relaxed)/cast(f64)time_stamp__freq());
+		gb_printf("string_intern lost races     - %td\n", string_intern_lost_race_count.load(std::memory_order_relaxed));
+	}
+
 	if (!(build_context.export_timings_format == TimingsExportUnspecified)) {
 		timings_export_all(t, c, true);
 	}
@@ -2122,6 +2167,19 @@ void print_show_help(String const arg0, String const &command) {
 		print_usage_line(2, "Normally, a single build unit is generated for a standard project");
 		print_usage_line(0, "");
 
+		print_usage_line(1, "-codegen-units:<integer>");
+		print_usage_line(2, "With -use-separate-modules, the maximum number of build units a large package is split into");
+		print_usage_line(2, "The default is the number of threads (see -thread-count)");
+		print_usage_line(2, "Example: -codegen-units:8");
+		print_usage_line(0, "");
+
+		print_usage_line(1, "-lto");
+		print_usage_line(1, "[EXPERIMENTAL]");
+		print_usage_line(2, "Implies -use-separate-modules");
+		print_usage_line(2, "The build units are generated in parallel and then linked together before the module optimization passes");
+		print_usage_line(2, "This allows for procedures to be inlined across packages");
+		print_usage_line(0, "");
+
 	}
 
 	if (check) {
@@ -2136,6 +2194,11 @@ void print_show_help(String const arg0, String const &command) {
 		print_usage_line(0, "");
 		#endif
 
+		print_usage_line(1, "-memory-map-source-files");
+		print_usage_line(2, "Memory maps the source files rather than copying them into memory");
+		print_usage_line(2, "A source file which is truncated whilst compiling may crash the compiler");
+		print_usage_line(0, "");
+
 		print_usage_line(1, "-vet");
 		print_usage_line(2, "Do extra checks on the code");
 		print_usage_line(2, "Extra checks include:");
@@ -2302,7 +2365,7 @@ void print_show_unused(Checker *c) {
 		if (e->token.string == "_") {
 			continue;
 		}
-		if (ptr_set_exists(&info->minimum_dependency_set, e)) {
+		if (is_entity_a_minimum_dependency(e)) {
 			continue;
 		}
 		array_add(&unused, e);
@@ -2369,15 +2432,15 @@ gbFileError write_file_with_stripped_tokens(gbFile *f, AstFile *file, i64 *writt
 	i32 prev_offset = 0;
 	i32 const end_offset = cast(i32)(file->tokenizer.end - file->tokenizer.start);
 	for_array(i, file->tokens) {
-		Token *token = &file->tokens[i];
+		CompactToken *token = &file->tokens[i];
 		if (token->flags & (TokenFlag_Remove|TokenFlag_Replace)) {
-			i32 offset = token->pos.offset;
+			i32 offset = token->offset;
 			i32 to_write = offset-prev_offset;
 			if (!gb_file_write(f, file_data+prev_offset, to_write)) {
 				return gbFileError_Invalid;
 			}
 			written += to_write;
-			prev_offset = token_pos_end(*token).offset;
+			prev_offset = token->offset + token->len;
 		}
 		if (token->flags & TokenFlag_Replace) {
 			if (token->kind == Token_Ellipsis) {
@@ -2418,7 +2481,7 @@ int strip_semicolons(Parser *parser) {
 
 			bool nothing_to_change = true;
 			for_array(i, file->tokens) {
-				Token *token = &file->tokens[i];
+				CompactToken *token = &file->tokens[i];
 				if (token->flags) {
 					nothing_to_change = false;
 					break;
@@ -2559,7 +2622,6 @@ int main(int arg_count, char const **arg_ptr) {
 
 	virtual_memory_init();
 	mutex_init(&fullpath_mutex);
-	mutex_init(&hash_exact_value_mutex);
 	mutex_init(&global_type_name_objc_metadata_mutex);
 
 	init_string_buffer_memory();
@@ -62,51 +62,130 @@ isize ast_node_size(AstKind kind) {
 }
 
 gb_global std::atomic<isize> global_total_node_memory_allocated;
+gb_global std::atomic<isize> global_total_node_block_memory_used;
+gb_global std::atomic<isize> global_total_node_block_memory_reserved;
+gb_global std::atomic<isize> global_node_block_overflow_count;
+
+u8 *ast_file_node_block_alloc(AstFile *f, isize size) {
+	MemoryBlock *block = f->node_block;
+	if (block == nullptr) {
+		return nullptr;
+	}
+	isize offset = align_formula_isize(block->used, GB_DEFAULT_MEMORY_ALIGNMENT);
+	if (offset + size > block->size) {
+		return nullptr;
+	}
+	block->used = offset + size;
+	// NOTE: memory will be zeroed by default due to virtual memory
+	return block->base + offset;
+}
 
 // NOTE(bill): And this below is why is I/we need a new language! Discriminated unions are a pain in C/C++
 Ast *alloc_ast_node(AstFile *f, AstKind kind) {
-	gbAllocator a = ast_allocator(f);
-
 	isize size = ast_node_size(kind);
+	isize prefix = 0;
+	if (ast_kind_has_type_and_value(kind)) {
+		prefix = align_formula_isize(gb_size_of(TypeAndValue), gb_align_of(Ast));
+		GB_ASSERT(prefix == gb_size_of(TypeAndValue));
+	}
 
-	Ast *node = cast(Ast *)gb_alloc(a, size);
+	u8 *data = nullptr;
+	if (f != nullptr && f == global_thread_local_parsing_ast_file) {
+		data = ast_file_node_block_alloc(f, prefix + size);
+		if (data == nullptr) {
+			global_node_block_overflow_count.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+	if (data == nullptr) {
+		data = cast(u8 *)gb_alloc(ast_allocator(f), prefix + size);
+	}
+	Ast *node = cast(Ast *)(data + prefix);
 	node->kind = kind;
 	node->file_id = f ? f->id : 0;
 
-	global_total_node_memory_allocated += size;
+	global_total_node_memory_allocated += prefix + size;
 
 	return node;
 }
 
-Ast *clone_ast(Ast *node);
-Array<Ast *> clone_ast_array(Array<Ast *> const &array) {
+// NOTE: A range of a file's node block which has been copied all at once by `clone_ast`
+struct AstCloneRange {
+	u8 *  begin;
+	u8 *  end;
+	isize delta; // added to the address of a node within [begin, end) gives its copy
+};
+
+Ast *clone_ast(Ast *node, AstCloneRange *range=nullptr);
+Array<Ast *> clone_ast_array(Array<Ast *> const &array, AstCloneRange *range) {
 	Array<Ast *> result = {};
 	if (array.count > 0) {
 		result = array_make<Ast *>(ast_allocator(nullptr), array.count);
 		for_array(i, array) {
-			result[i] = clone_ast(array[i]);
+			result[i] = clone_ast(array[i], range);
 		}
 	}
 	return result;
 }
-Slice<Ast *> clone_ast_array(Slice<Ast *> const &array) {
+Slice<Ast *> clone_ast_array(Slice<Ast *> const &array, AstCloneRange *range) {
 	Slice<Ast *> result = {};
 	if (array.count > 0) {
 		result = slice_clone(permanent_allocator(), array);
 		for_array(i, array) {
-			result[i] = clone_ast(array[i]);
+			result[i] = clone_ast(array[i], range);
 		}
 	}
 	return result;
 }
 
-Ast *clone_ast(Ast *node) {
+// NOTE: All of the nodes of a procedure literal were allocated one after another while parsing it,
+// so they are copied with a single memcpy and `clone_ast` then only has to relocate the references
+// between them. Any reference outside of the range is cloned node by node as before.
+AstCloneRange *clone_ast_proc_lit_range(Ast *node, AstCloneRange *range) {
+	GB_ASSERT(node->kind == Ast_ProcLit);
+	u32 begin = node->ProcLit.node_begin;
+	u32 end   = node->ProcLit.node_end;
+	if (begin >= end) {
+		return nullptr;
+	}
+	AstFile *f = node->file();
+	if (!ast_file_owns_node(f, node) || ast_file_node_offset(f, node) < begin || ast_file_node_offset(f, node) >= end) {
+		// NOTE: e.g. this is itself a copy
+		return nullptr;
+	}
+	isize size = end - begin;
+	u8 *data = cast(u8 *)gb_alloc_align(ast_allocator(nullptr), size, GB_DEFAULT_MEMORY_ALIGNMENT);
+	gb_memmove(data, f->node_block->base + begin, size);
+	global_total_node_memory_allocated += size;
+
+	range->begin = f->node_block->base + begin;
+	range->end   = f->node_block->base + end;
+	range->delta = data - range->begin;
+	return range;
+}
+
+Ast *clone_ast(Ast *node, AstCloneRange *range) {
 	if (node == nullptr) {
 		return nullptr;
 	}
-	AstFile *f = node->thread_safe_file();
-	Ast *n = alloc_ast_node(f, node->kind);
-	gb_memmove(n, node, ast_node_size(node->kind));
+	AstCloneRange proc_lit_range = {};
+	if (range == nullptr && node->kind == Ast_ProcLit) {
+		range = clone_ast_proc_lit_range(node, &proc_lit_range);
+	}
+
+	Ast *n = nullptr;
+	u8 *ptr = cast(u8 *)node;
+	if (range != nullptr && range->begin <= ptr && ptr < range->end) {
+		// NOTE: already copied along with its type and value
+		n = cast(Ast *)(ptr + range->delta);
+	} else {
+		// NOTE: The file is only needed for the `file_id`, which the copy below overwrites anyway,
+		// so do not look it up through the global (locked) file table for every node
+		n = alloc_ast_node(nullptr, node->kind);
+		gb_memmove(n, node, ast_node_size(node->kind));
+		if (ast_kind_has_type_and_value(n->kind)) {
+			n->mutable_tav() = node->tav();
+		}
+	}
 
 	switch (n->kind) {
 	default: GB_PANIC("Unhandled Ast %.*s", LIT(ast_strings[n->kind])); break;
@@ -121,281 +200,281 @@ Ast *clone_ast(Ast *node) {
 	case Ast_BasicDirective: break;
 
 	case Ast_PolyType:
-		n->PolyType.type           = clone_ast(n->PolyType.type);
-		n->PolyType.specialization = clone_ast(n->PolyType.specialization);
+		n->PolyType.type           = clone_ast(n->PolyType.type, range);
+		n->PolyType.specialization = clone_ast(n->PolyType.specialization, range);
 		break;
 	case Ast_Ellipsis:
-		n->Ellipsis.expr = clone_ast(n->Ellipsis.expr);
+		n->Ellipsis.expr = clone_ast(n->Ellipsis.expr, range);
 		break;
 	case Ast_ProcGroup:
-		n->ProcGroup.args = clone_ast_array(n->ProcGroup.args);
+		n->ProcGroup.args = clone_ast_array(n->ProcGroup.args, range);
 		break;
 	case Ast_ProcLit:
-		n->ProcLit.type = clone_ast(n->ProcLit.type);
-		n->ProcLit.body = clone_ast(n->ProcLit.body);
-		n->ProcLit.where_clauses = clone_ast_array(n->ProcLit.where_clauses);
+		n->ProcLit.type = clone_ast(n->ProcLit.type, range);
+		n->ProcLit.body = clone_ast(n->ProcLit.body, range);
+		n->ProcLit.where_clauses = clone_ast_array(n->ProcLit.where_clauses, range);
 		break;
 	case Ast_CompoundLit:
-		n->CompoundLit.type  = clone_ast(n->CompoundLit.type);
-		n->CompoundLit.elems = clone_ast_array(n->CompoundLit.elems);
+		n->CompoundLit.type  = clone_ast(n->CompoundLit.type, range);
+		n->CompoundLit.elems = clone_ast_array(n->CompoundLit.elems, range);
 		break;
 
 	case Ast_BadExpr: break;
 	case Ast_TagExpr:
-		n->TagExpr.expr = clone_ast(n->TagExpr.expr);
+		n->TagExpr.expr = clone_ast(n->TagExpr.expr, range);
 		break;
 	case Ast_UnaryExpr:
-		n->UnaryExpr.expr = clone_ast(n->UnaryExpr.expr);
+		n->UnaryExpr.expr = clone_ast(n->UnaryExpr.expr, range);
 		break;
 	case Ast_BinaryExpr:
-		n->BinaryExpr.left  = clone_ast(n->BinaryExpr.left);
-		n->BinaryExpr.right = clone_ast(n->BinaryExpr.right);
+		n->BinaryExpr.left  = clone_ast(n->BinaryExpr.left, range);
+		n->BinaryExpr.right = clone_ast(n->BinaryExpr.right, range);
 		break;
 	case Ast_ParenExpr:
-		n->ParenExpr.expr = clone_ast(n->ParenExpr.expr);
+		n->ParenExpr.expr = clone_ast(n->ParenExpr.expr, range);
 		break;
 	case Ast_SelectorExpr:
-		n->SelectorExpr.expr = clone_ast(n->SelectorExpr.expr);
-		n->SelectorExpr.selector = clone_ast(n->SelectorExpr.selector);
+		n->SelectorExpr.expr = clone_ast(n->SelectorExpr.expr, range);
+		n->SelectorExpr.selector = clone_ast(n->SelectorExpr.selector, range);
 		break;
 	case Ast_ImplicitSelectorExpr:
-		n->ImplicitSelectorExpr.selector = clone_ast(n->ImplicitSelectorExpr.selector);
+		n->ImplicitSelectorExpr.selector = clone_ast(n->ImplicitSelectorExpr.selector, range);
 		break;
 	case Ast_SelectorCallExpr:
-		n->SelectorCallExpr.expr = clone_ast(n->SelectorCallExpr.expr);
-		n->SelectorCallExpr.call = clone_ast(n->SelectorCallExpr.call);
+		n->SelectorCallExpr.expr = clone_ast(n->SelectorCallExpr.expr, range);
+		n->SelectorCallExpr.call = clone_ast(n->SelectorCallExpr.call, range);
 		break;
 	case Ast_IndexExpr:
-		n->IndexExpr.expr  = clone_ast(n->IndexExpr.expr);
-		n->IndexExpr.index = clone_ast(n->IndexExpr.index);
+		n->IndexExpr.expr  = clone_ast(n->IndexExpr.expr, range);
+		n->IndexExpr.index = clone_ast(n->IndexExpr.index, range);
 		break;
 	case Ast_MatrixIndexExpr:
-		n->MatrixIndexExpr.expr  = clone_ast(n->MatrixIndexExpr.expr);
-		n->MatrixIndexExpr.row_index = clone_ast(n->MatrixIndexExpr.row_index);
-		n->MatrixIndexExpr.column_index = clone_ast(n->MatrixIndexExpr.column_index);
+		n->MatrixIndexExpr.expr  = clone_ast(n->MatrixIndexExpr.expr, range);
+		n->MatrixIndexExpr.row_index = clone_ast(n->MatrixIndexExpr.row_index, range);
+		n->MatrixIndexExpr.column_index = clone_ast(n->MatrixIndexExpr.column_index, range);
 		break;
 	case Ast_DerefExpr:
-		n->DerefExpr.expr = clone_ast(n->DerefExpr.expr);
+		n->DerefExpr.expr = clone_ast(n->DerefExpr.expr, range);
 		break;
 	case Ast_SliceExpr:
-		n->SliceExpr.expr = clone_ast(n->SliceExpr.expr);
-		n->SliceExpr.low  = clone_ast(n->SliceExpr.low);
-		n->SliceExpr.high = clone_ast(n->SliceExpr.high);
+		n->SliceExpr.expr = clone_ast(n->SliceExpr.expr, range);
+		n->SliceExpr.low  = clone_ast(n->SliceExpr.low, range);
+		n->SliceExpr.high = clone_ast(n->SliceExpr.high, range);
 		break;
 	case Ast_CallExpr:
-		n->CallExpr.proc = clone_ast(n->CallExpr.proc);
-		n->CallExpr.args = clone_ast_array(n->CallExpr.args);
+		n->CallExpr.proc = clone_ast(n->CallExpr.proc, range);
+		n->CallExpr.args = clone_ast_array(n->CallExpr.args, range);
 		break;
 
 	case Ast_FieldValue:
-		n->FieldValue.field = clone_ast(n->FieldValue.field);
-		n->FieldValue.value = clone_ast(n->FieldValue.value);
+		n->FieldValue.field = clone_ast(n->FieldValue.field, range);
+		n->FieldValue.value = clone_ast(n->FieldValue.value, range);
 		break;
 
 	case Ast_EnumFieldValue:
-		n->EnumFieldValue.name = clone_ast(n->EnumFieldValue.name);
-		n->EnumFieldValue.value = clone_ast(n->EnumFieldValue.value);
+		n->EnumFieldValue.name = clone_ast(n->EnumFieldValue.name, range);
+		n->EnumFieldValue.value = clone_ast(n->EnumFieldValue.value, range);
 		break;
 
 	case Ast_TernaryIfExpr:
-		n->TernaryIfExpr.x    = clone_ast(n->TernaryIfExpr.x);
-		n->TernaryIfExpr.cond = clone_ast(n->TernaryIfExpr.cond);
-		n->TernaryIfExpr.y    = clone_ast(n->TernaryIfExpr.y);
+		n->TernaryIfExpr.x    = clone_ast(n->TernaryIfExpr.x, range);
+		n->TernaryIfExpr.cond = clone_ast(n->TernaryIfExpr.cond, range);
+		n->TernaryIfExpr.y    = clone_ast(n->TernaryIfExpr.y, range);
 		break;
 	case Ast_TernaryWhenExpr:
-		n->TernaryWhenExpr.x    = clone_ast(n->TernaryWhenExpr.x);
-		n->TernaryWhenExpr.cond = clone_ast(n->TernaryWhenExpr.cond);
-		n->TernaryWhenExpr.y    = clone_ast(n->TernaryWhenExpr.y);
+		n->TernaryWhenExpr.x    = clone_ast(n->TernaryWhenExpr.x, range);
+		n->TernaryWhenExpr.cond = clone_ast(n->TernaryWhenExpr.cond, range);
+		n->TernaryWhenExpr.y    = clone_ast(n->TernaryWhenExpr.y, range);
 		break;
 	case Ast_OrElseExpr:
-		n->OrElseExpr.x = clone_ast(n->OrElseExpr.x);
-		n->OrElseExpr.y = clone_ast(n->OrElseExpr.y);
+		n->OrElseExpr.x = clone_ast(n->OrElseExpr.x, range);
+		n->OrElseExpr.y = clone_ast(n->OrElseExpr.y, range);
 		break;
 	case Ast_OrReturnExpr:
-		n->OrReturnExpr.expr = clone_ast(n->OrReturnExpr.expr);
+		n->OrReturnExpr.expr = clone_ast(n->OrReturnExpr.expr, range);
 		break;
 	case Ast_TypeAssertion:
-		n->TypeAssertion.expr = clone_ast(n->TypeAssertion.expr);
-		n->TypeAssertion.type = clone_ast(n->TypeAssertion.type);
+		n->TypeAssertion.expr = clone_ast(n->TypeAssertion.expr, range);
+		n->TypeAssertion.type = clone_ast(n->TypeAssertion.type, range);
 		break;
 	case Ast_TypeCast:
-		n->TypeCast.type = clone_ast(n->TypeCast.type);
-		n->TypeCast.expr = clone_ast(n->TypeCast.expr);
+		n->TypeCast.type = clone_ast(n->TypeCast.type, range);
+		n->TypeCast.expr = clone_ast(n->TypeCast.expr, range);
 		break;
 	case Ast_AutoCast:
-		n->AutoCast.expr = clone_ast(n->AutoCast.expr);
+		n->AutoCast.expr = clone_ast(n->AutoCast.expr, range);
 		break;
 
 	case Ast_InlineAsmExpr:
-		n->InlineAsmExpr.param_types        = clone_ast_array(n->InlineAsmExpr.param_types);
-		n->InlineAsmExpr.return_type        = clone_ast(n->InlineAsmExpr.return_type);
-		n->InlineAsmExpr.asm_string         = clone_ast(n->InlineAsmExpr.asm_string);
-		n->InlineAsmExpr.constraints_string = clone_ast(n->InlineAsmExpr.constraints_string);
+		n->InlineAsmExpr.param_types        = clone_ast_array(n->InlineAsmExpr.param_types, range);
+		n->InlineAsmExpr.return_type        = clone_ast(n->InlineAsmExpr.return_type, range);
+		n->InlineAsmExpr.asm_string         = clone_ast(n->InlineAsmExpr.asm_string, range);
+		n->InlineAsmExpr.constraints_string = clone_ast(n->InlineAsmExpr.constraints_string, range);
 		break;
 
 	case Ast_BadStmt:   break;
 	case Ast_EmptyStmt: break;
 	case Ast_ExprStmt:
-		n->ExprStmt.expr = clone_ast(n->ExprStmt.expr);
+		n->ExprStmt.expr = clone_ast(n->ExprStmt.expr, range);
 		break;
 	case Ast_TagStmt:
-		n->TagStmt.stmt = clone_ast(n->TagStmt.stmt);
+		n->TagStmt.stmt = clone_ast(n->TagStmt.stmt, range);
 		break;
 	case Ast_AssignStmt:
-		n->AssignStmt.lhs = clone_ast_array(n->AssignStmt.lhs);
-		n->AssignStmt.rhs = clone_ast_array(n->AssignStmt.rhs);
+		n->AssignStmt.lhs = clone_ast_array(n->AssignStmt.lhs, range);
+		n->AssignStmt.rhs = clone_ast_array(n->AssignStmt.rhs, range);
 		break;
 	case Ast_BlockStmt:
-		n->BlockStmt.label = clone_ast(n->BlockStmt.label);
-		n->BlockStmt.stmts = clone_ast_array(n->BlockStmt.stmts);
+		n->BlockStmt.label = clone_ast(n->BlockStmt.label, range);
+		n->BlockStmt.stmts = clone_ast_array(n->BlockStmt.stmts, range);
 		break;
 	case Ast_IfStmt:
-		n->IfStmt.label = clone_ast(n->IfStmt.label);
-		n->IfStmt.init = clone_ast(n->IfStmt.init);
-		n->IfStmt.cond = clone_ast(n->IfStmt.cond);
-		n->IfStmt.body = clone_ast(n->IfStmt.body);
-		n->IfStmt.else_stmt = clone_ast(n->IfStmt.else_stmt);
+		n->IfStmt.label = clone_ast(n->IfStmt.label, range);
+		n->IfStmt.init = clone_ast(n->IfStmt.init, range);
+		n->IfStmt.cond = clone_ast(n->IfStmt.cond, range);
+		n->IfStmt.body = clone_ast(n->IfStmt.body, range);
+		n->IfStmt.else_stmt = clone_ast(n->IfStmt.else_stmt, range);
 		break;
 	case Ast_WhenStmt:
-		n->WhenStmt.cond = clone_ast(n->WhenStmt.cond);
-		n->WhenStmt.body = clone_ast(n->WhenStmt.body);
-		n->WhenStmt.else_stmt = clone_ast(n->WhenStmt.else_stmt);
+		n->WhenStmt.cond = clone_ast(n->WhenStmt.cond, range);
+		n->WhenStmt.body = clone_ast(n->WhenStmt.body, range);
+		n->WhenStmt.else_stmt = clone_ast(n->WhenStmt.else_stmt, range);
 		break;
 	case Ast_ReturnStmt:
-		n->ReturnStmt.results = clone_ast_array(n->ReturnStmt.results);
+		n->ReturnStmt.results = clone_ast_array(n->ReturnStmt.results, range);
 		break;
 	case Ast_ForStmt:
-		n->ForStmt.label = clone_ast(n->ForStmt.label);
-		n->ForStmt.init  = clone_ast(n->ForStmt.init);
-		n->ForStmt.cond  = clone_ast(n->ForStmt.cond);
-		n->ForStmt.post  = clone_ast(n->ForStmt.post);
-		n->ForStmt.body  = clone_ast(n->ForStmt.body);
+		n->ForStmt.label = clone_ast(n->ForStmt.label, range);
+		n->ForStmt.init  = clone_ast(n->ForStmt.init, range);
+		n->ForStmt.cond  = clone_ast(n->ForStmt.cond, range);
+		n->ForStmt.post  = clone_ast(n->ForStmt.post, range);
+		n->ForStmt.body  = clone_ast(n->ForStmt.body, range);
 		break;
 	case Ast_RangeStmt:
-		n->RangeStmt.label = clone_ast(n->RangeStmt.label);
-		n->RangeStmt.vals  = clone_ast_array(n->RangeStmt.vals);
-		n->RangeStmt.expr  = clone_ast(n->RangeStmt.expr);
-		n->RangeStmt.body  = clone_ast(n->RangeStmt.body);
+		n->RangeStmt.label = clone_ast(n->RangeStmt.label, range);
+		n->RangeStmt.vals  = clone_ast_array(n->RangeStmt.vals, range);
+		n->RangeStmt.expr  = clone_ast(n->RangeStmt.expr, range);
+		n->RangeStmt.body  = clone_ast(n->RangeStmt.body, range);
 		break;
 	case Ast_UnrollRangeStmt:
-		n->UnrollRangeStmt.val0  = clone_ast(n->UnrollRangeStmt.val0);
-		n->UnrollRangeStmt.val1  = clone_ast(n->UnrollRangeStmt.val1);
-		n->UnrollRangeStmt.expr  = clone_ast(n->UnrollRangeStmt.expr);
-		n->UnrollRangeStmt.body  = clone_ast(n->UnrollRangeStmt.body);
+		n->UnrollRangeStmt.val0  = clone_ast(n->UnrollRangeStmt.val0, range);
+		n->UnrollRangeStmt.val1  = clone_ast(n->UnrollRangeStmt.val1, range);
+		n->UnrollRangeStmt.expr  = clone_ast(n->UnrollRangeStmt.expr, range);
+		n->UnrollRangeStmt.body  = clone_ast(n->UnrollRangeStmt.body, range);
 		break;
 	case Ast_CaseClause:
-		n->CaseClause.list  = clone_ast_array(n->CaseClause.list);
-		n->CaseClause.stmts = clone_ast_array(n->CaseClause.stmts);
+		n->CaseClause.list  = clone_ast_array(n->CaseClause.list, range);
+		n->CaseClause.stmts = clone_ast_array(n->CaseClause.stmts, range);
 		n->CaseClause.implicit_entity = nullptr;
 		break;
 	case Ast_SwitchStmt:
-		n->SwitchStmt.label = clone_ast(n->SwitchStmt.label);
-		n->SwitchStmt.init  = clone_ast(n->SwitchStmt.init);
-		n->SwitchStmt.tag   = clone_ast(n->SwitchStmt.tag);
-		n->SwitchStmt.body  = clone_ast(n->SwitchStmt.body);
+		n->SwitchStmt.label = clone_ast(n->SwitchStmt.label, range);
+		n->SwitchStmt.init  = clone_ast(n->SwitchStmt.init, range);
+		n->SwitchStmt.tag   = clone_ast(n->SwitchStmt.tag, range);
+		n->SwitchStmt.body  = clone_ast(n->SwitchStmt.body, range);
 		break;
 	case Ast_TypeSwitchStmt:
-		n->TypeSwitchStmt.label = clone_ast(n->TypeSwitchStmt.label);
-		n->TypeSwitchStmt.tag   = clone_ast(n->TypeSwitchStmt.tag);
-		n->TypeSwitchStmt.body  = clone_ast(n->TypeSwitchStmt.body);
+		n->TypeSwitchStmt.label = clone_ast(n->TypeSwitchStmt.label, range);
+		n->TypeSwitchStmt.tag   = clone_ast(n->TypeSwitchStmt.tag, range);
+		n->TypeSwitchStmt.body  = clone_ast(n->TypeSwitchStmt.body, range);
 		break;
 	case Ast_DeferStmt:
-		n->DeferStmt.stmt = clone_ast(n->DeferStmt.stmt);
+		n->DeferStmt.stmt = clone_ast(n->DeferStmt.stmt, range);
 		break;
 	case Ast_BranchStmt:
-		n->BranchStmt.label = clone_ast(n->BranchStmt.label);
+		n->BranchStmt.label = clone_ast(n->BranchStmt.label, range);
 		break;
 	case Ast_UsingStmt:
-		n->UsingStmt.list = clone_ast_array(n->UsingStmt.list);
+		n->UsingStmt.list = clone_ast_array(n->UsingStmt.list, range);
 		break;
 
 	case Ast_BadDecl: break;
 
 	case Ast_ForeignBlockDecl:
-		n->ForeignBlockDecl.foreign_library = clone_ast(n->ForeignBlockDecl.foreign_library);
-		n->ForeignBlockDecl.body            = clone_ast(n->ForeignBlockDecl.body);
-		n->ForeignBlockDecl.attributes      = clone_ast_array(n->ForeignBlockDecl.attributes);
+		n->ForeignBlockDecl.foreign_library = clone_ast(n->ForeignBlockDecl.foreign_library, range);
+		n->ForeignBlockDecl.body            = clone_ast(n->ForeignBlockDecl.body, range);
+		n->ForeignBlockDecl.attributes      = clone_ast_array(n->ForeignBlockDecl.attributes, range);
 		break;
 	case Ast_Label:
-		n->Label.name = clone_ast(n->Label.name);
+		n->Label.name = clone_ast(n->Label.name, range);
 		break;
 	case Ast_ValueDecl:
-		n->ValueDecl.names  = clone_ast_array(n->ValueDecl.names);
-		n->ValueDecl.type   = clone_ast(n->ValueDecl.type);
-		n->ValueDecl.values = clone_ast_array(n->ValueDecl.values);
-		n->ValueDecl.attributes = clone_ast_array(n->ValueDecl.attributes);
+		n->ValueDecl.names  = clone_ast_array(n->ValueDecl.names, range);
+		n->ValueDecl.type   = clone_ast(n->ValueDecl.type, range);
+		n->ValueDecl.values = clone_ast_array(n->ValueDecl.values, range);
+		n->ValueDecl.attributes = clone_ast_array(n->ValueDecl.attributes, range);
 		break;
 
 	case Ast_Attribute:
-		n->Attribute.elems = clone_ast_array(n->Attribute.elems);
+		n->Attribute.elems = clone_ast_array(n->Attribute.elems, range);
 		break;
 	case Ast_Field:
-		n->Field.names = clone_ast_array(n->Field.names);
-		n->Field.type  = clone_ast(n->Field.type);
+		n->Field.names = clone_ast_array(n->Field.names, range);
+		n->Field.type  = clone_ast(n->Field.type, range);
 		break;
 	case Ast_FieldList:
-		n->FieldList.list = clone_ast_array(n->FieldList.list);
+		n->FieldList.list = clone_ast_array(n->FieldList.list, range);
 		break;
 
 	case Ast_TypeidType:
-		n->TypeidType.specialization = clone_ast(n->TypeidType.specialization);
+		n->TypeidType.specialization = clone_ast(n->TypeidType.specialization, range);
 		break;
 	case Ast_HelperType:
-		n->HelperType.type = clone_ast(n->HelperType.type);
+		n->HelperType.type = clone_ast(n->HelperType.type, range);
 		break;
 	case Ast_DistinctType:
-		n->DistinctType.type = clone_ast(n->DistinctType.type);
+		n->DistinctType.type = clone_ast(n->DistinctType.type, range);
 		break;
 	case Ast_ProcType:
-		n->ProcType.params  = clone_ast(n->ProcType.params);
-		n->ProcType.results = clone_ast(n->ProcType.results);
+		n->ProcType.params  = clone_ast(n->ProcType.params, range);
+		n->ProcType.results = clone_ast(n->ProcType.results, range);
 		break;
 	case Ast_RelativeType:
-		n->RelativeType.tag  = clone_ast(n->RelativeType.tag);
-		n->RelativeType.type = clone_ast(n->RelativeType.type);
+		n->RelativeType.tag  = clone_ast(n->RelativeType.tag, range);
+		n->RelativeType.type = clone_ast(n->RelativeType.type, range);
 		break;
 	case Ast_PointerType:
-		n->PointerType.type = clone_ast(n->PointerType.type);
+		n->PointerType.type = clone_ast(n->PointerType.type, range);
 		break;
 	case Ast_MultiPointerType:
-		n->MultiPointerType.type = clone_ast(n->MultiPointerType.type);
+		n->MultiPointerType.type = clone_ast(n->MultiPointerType.type, range);
 		break;
 	case Ast_ArrayType:
-		n->ArrayType.count = clone_ast(n->ArrayType.count);
-		n->ArrayType.elem  = clone_ast(n->ArrayType.elem);
-		n->ArrayType.tag   = clone_ast(n->ArrayType.tag);
+		n->ArrayType.count = clone_ast(n->ArrayType.count, range);
+		n->ArrayType.elem  = clone_ast(n->ArrayType.elem, range);
+		n->ArrayType.tag   = clone_ast(n->ArrayType.tag, range);
 		break;
 	case Ast_DynamicArrayType:
-		n->DynamicArrayType.elem = clone_ast(n->DynamicArrayType.elem);
+		n->DynamicArrayType.elem = clone_ast(n->DynamicArrayType.elem, range);
 		break;
 	case Ast_StructType:
-		n->StructType.fields = clone_ast_array(n->StructType.fields);
-		n->StructType.polymorphic_params = clone_ast(n->StructType.polymorphic_params);
-		n->StructType.align  = clone_ast(n->StructType.align);
-		n->StructType.where_clauses  = clone_ast_array(n->StructType.where_clauses);
+		n->StructType.fields = clone_ast_array(n->StructType.fields, range);
+		n->StructType.polymorphic_params = clone_ast(n->StructType.polymorphic_params, range);
+		n->StructType.align  = clone_ast(n->StructType.align, range);
+		n->StructType.where_clauses  = clone_ast_array(n->StructType.where_clauses, range);
 		break;
 	case Ast_UnionType:
-		n->UnionType.variants = clone_ast_array(n->UnionType.variants);
-		n->UnionType.polymorphic_params = clone_ast(n->UnionType.polymorphic_params);
-		n->UnionType.where_clauses = clone_ast_array(n->UnionType.where_clauses);
+		n->UnionType.variants = clone_ast_array(n->UnionType.variants, range);
+		n->UnionType.polymorphic_params = clone_ast(n->UnionType.polymorphic_params, range);
+		n->UnionType.where_clauses = clone_ast_array(n->UnionType.where_clauses, range);
 		break;
 	case Ast_EnumType:
-		n->EnumType.base_type = clone_ast(n->EnumType.base_type);
-		n->EnumType.fields    = clone_ast_array(n->EnumType.fields);
+		n->EnumType.base_type = clone_ast(n->EnumType.base_type, range);
+		n->EnumType.fields    = clone_ast_array(n->EnumType.fields, range);
 		break;
 	case Ast_BitSetType:
-		n->BitSetType.elem       = clone_ast(n->BitSetType.elem);
-		n->BitSetType.underlying = clone_ast(n->BitSetType.underlying);
+		n->BitSetType.elem       = clone_ast(n->BitSetType.elem, range);
+		n->BitSetType.underlying = clone_ast(n->BitSetType.underlying, range);
 		break;
 	case Ast_MapType:
-		n->MapType.count = clone_ast(n->MapType.count);
-		n->MapType.key   = clone_ast(n->MapType.key);
-		n->MapType.value = clone_ast(n->MapType.value);
+		n->MapType.count = clone_ast(n->MapType.count, range);
+		n->MapType.key   = clone_ast(n->MapType.key, range);
+		n->MapType.value = clone_ast(n->MapType.value, range);
 		break;
 	case Ast_MatrixType:
-		n->MatrixType.row_count    = clone_ast(n->MatrixType.row_count);
-		n->MatrixType.column_count = clone_ast(n->MatrixType.column_count);
-		n->MatrixType.elem         = clone_ast(n->MatrixType.elem);
+		n->MatrixType.row_count    = clone_ast(n->MatrixType.row_count, range);
+		n->MatrixType.column_count = clone_ast(n->MatrixType.column_count, range);
+		n->MatrixType.elem         = clone_ast(n->MatrixType.elem, range);
 		break;
 	}
 
@@ -616,7 +695,13 @@ Ast *ast_matrix_index_expr(AstFile *f, Ast *expr, Token open, Token close, Token
 
 Ast *ast_ident(AstFile *f, Token token) {
 	Ast *result = alloc_ast_node(f, Ast_Ident);
+	// NOTE: Identifiers are interned so that the same name shares the same memory across all files,
+	// which allows the scope maps to compare names by pointer, and the hash is only ever computed once
+	if (token.string.len > 0) {
+		token.string.text = cast(u8 *)string_intern(token.string);
+	}
 	result->Ident.token = token;
+	result->Ident.hash  = fnv32a(token.string.text, token.string.len);
 	return result;
 }
 
@@ -661,8 +746,8 @@ String string_value_from_token(AstFile *f, Token const &token) {
 Ast *ast_basic_lit(AstFile *f, Token basic_lit) {
 	Ast *result = alloc_ast_node(f, Ast_BasicLit);
 	result->BasicLit.token = basic_lit;
-	result->tav.mode = Addressing_Constant;
-	result->tav.value = exact_value_from_token(f, basic_lit);
+	result->mutable_tav().mode = Addressing_Constant;
+	result->mutable_tav().value = exact_value_from_token(f, basic_lit);
 	return result;
 }
 
@@ -690,13 +775,15 @@ Ast *ast_proc_group(AstFile *f, Token token, Token open, Token close, Array<Ast
 	return result;
 }
 
-Ast *ast_proc_lit(AstFile *f, Ast *type, Ast *body, u64 tags, Token where_token, Array<Ast *> const &where_clauses) {
+Ast *ast_proc_lit(AstFile *f, Ast *type, Ast *body, u64 tags, Token where_token, Array<Ast *> const &where_clauses, u32 node_begin) {
 	Ast *result = alloc_ast_node(f, Ast_ProcLit);
 	result->ProcLit.type = type;
 	result->ProcLit.body = body;
 	result->ProcLit.tags = tags;
 	result->ProcLit.where_token = where_token;
 	result->ProcLit.where_clauses = slice_from_array(where_clauses);
+	result->ProcLit.node_begin = node_begin;
+	result->ProcLit.node_end = ast_file_node_block_used(f);
 	return result;
 }
 
@@ -1199,9 +1286,101 @@ Ast *ast_attribute(AstFile *f, Token token, Token open, Token close, Array<Ast *
 }
 
 
+i32 ast_file_line_of_offset(AstFile *f, i32 offset) {
+	// NOTE: Find the last line which starts at or before the offset
+	isize lo = 0;
+	isize hi = f->line_offsets.count;
+	while (hi - lo > 1) {
+		isize mid = lo + (hi-lo)/2;
+		if (f->line_offsets[mid] <= offset) {
+			lo = mid;
+		} else {
+			hi = mid;
+		}
+	}
+	return cast(i32)(lo+1);
+}
+
+i32 ast_file_rune_count(AstFile *f, i32 from, i32 to) {
+	u8 const *p   = f->tokenizer.start + from;
+	u8 const *end = f->tokenizer.start + to;
+	i32 count = 0;
+	while (p < end) {
+		if (*p < 0x80) {
+			p += 1;
+		} else {
+			Rune r = 0;
+			p += utf8_decode(p, f->tokenizer.end - p, &r);
+		}
+		count += 1;
+	}
+	return count;
+}
+
+i32 ast_file_token_column(AstFile *f, CompactToken const &ct, i32 line_offset) {
+	if (ct.column != 0) {
+		return ct.column;
+	}
+	// NOTE: The column did not fit in the token, so count the runes from the start of its line
+	i32 column = 1 + ast_file_rune_count(f, line_offset, ct.offset);
+	if (ct.offset > 0 && ct.offset >= f->tokenizer.end - f->tokenizer.start) {
+		// NOTE: The tokenizer does not advance the column when it reaches the end of the file
+		column -= 1;
+	}
+	return column;
+}
+
+TokenPos ast_file_token_pos(AstFile *f, CompactToken const &ct) {
+	TokenPos pos = {};
+	pos.file_id = f->id;
+	pos.offset  = ct.offset;
+	pos.line    = ast_file_line_of_offset(f, ct.offset);
+	pos.column  = ast_file_token_column(f, ct, f->line_offsets[pos.line-1]);
+	return pos;
+}
+
+Token ast_file_token_with_pos(AstFile *f, CompactToken const &ct, TokenPos const &pos) {
+	Token token = {};
+	token.kind  = cast(TokenKind)ct.kind;
+	token.flags = ct.flags;
+	token.pos   = pos;
+	if (ct.kind == Token_Semicolon && ct.offset >= f->tokenizer.end - f->tokenizer.start) {
+		// NOTE: Semicolon inserted at the end of the file
+		token.string = str_lit("\n");
+	} else {
+		token.string = make_string(f->tokenizer.start + ct.offset, ct.len);
+	}
+	return token;
+}
+
+Token ast_file_token(AstFile *f, isize index) {
+	CompactToken const &ct = f->tokens[index];
+	return ast_file_token_with_pos(f, ct, ast_file_token_pos(f, ct));
+}
+
+// NOTE: The parser needs the line of nearly every token it consumes (newlines end statements, comment
+// groups, etc.), so the position cannot be left unresolved. Tokens are consumed in order though, so the
+// line of the previous one is moved forward over the line starts in between rather than searched for.
+Token ast_file_token_sequential(AstFile *f, isize index) {
+	CompactToken const &ct = f->tokens[index];
+	TokenPos pos = f->token_pos_cursor;
+
+	if (pos.line > 0 && pos.offset <= ct.offset) {
+		while (pos.line < f->line_offsets.count && f->line_offsets[pos.line] <= ct.offset) {
+			pos.line += 1;
+		}
+		pos.offset = ct.offset;
+		pos.column = ast_file_token_column(f, ct, f->line_offsets[pos.line-1]);
+	} else {
+		pos = ast_file_token_pos(f, ct);
+	}
+	f->token_pos_cursor = pos;
+	return ast_file_token_with_pos(f, ct, pos);
+}
+
 bool next_token0(AstFile *f) {
 	if (f->curr_token_index+1 < f->tokens.count) {
-		f->curr_token = f->tokens[++f->curr_token_index];
+		f->curr_token = ast_file_token_sequential(f, ++f->curr_token_index);
 		return true;
 	}
 	syntax_error(f->curr_token, "Token is EOF");
@@ -1310,22 +1489,21 @@ Token advance_token(AstFile *f) {
 
 bool peek_token_kind(AstFile *f, TokenKind kind) {
 	for (isize i = f->curr_token_index+1; i < f->tokens.count; i++) {
-		Token tok = f->tokens[i];
-		if (kind != Token_Comment && tok.kind == Token_Comment) {
+		TokenKind tok_kind = cast(TokenKind)f->tokens[i].kind;
+		if (kind != Token_Comment && tok_kind == Token_Comment) {
 			continue;
 		}
-		return tok.kind == kind;
+		return tok_kind == kind;
 	}
 	return false;
 }
 
 Token peek_token(AstFile *f) {
 	for (isize i = f->curr_token_index+1; i < f->tokens.count; i++) {
-		Token tok = f->tokens[i];
-		if (tok.kind == Token_Comment) {
+		if (f->tokens[i].kind == Token_Comment) {
 			continue;
 		}
-		return tok;
+		return ast_file_token(f, i);
 	}
 	return {};
 }
@@ -1553,15 +1731,15 @@ Token expect_closing(AstFile *f, TokenKind kind, String const &context) {
 
 void assign_removal_flag_to_semicolon(AstFile *f) {
 	// NOTE(bill): this is used for rewriting files to strip unneeded semicolons
-	Token *prev_token = &f->tokens[f->prev_token_index];
-	Token *curr_token = &f->tokens[f->curr_token_index];
-	GB_ASSERT(prev_token->kind == Token_Semicolon);
-	if (prev_token->string == ";") {
+	Token prev_token = ast_file_token(f, f->prev_token_index);
+	Token curr_token = ast_file_token(f, f->curr_token_index);
+	GB_ASSERT(prev_token.kind == Token_Semicolon);
+	if (prev_token.string == ";") {
 		bool ok = false;
-		if (curr_token->pos.line > prev_token->pos.line) {
+		if (curr_token.pos.line > prev_token.pos.line) {
 			ok = true;
-		} else if (curr_token->pos.line == prev_token->pos.line) {
-			switch (curr_token->kind) {
+		} else if (curr_token.pos.line == prev_token.pos.line) {
+			switch (curr_token.kind) {
 			case Token_CloseBrace:
 			case Token_CloseParen:
 			case Token_EOF:
@@ -1572,11 +1750,11 @@ void assign_removal_flag_to_semicolon(AstFile *f) {
 			
 		if (ok) {
 			if (build_context.strict_style) {
-				syntax_error(*prev_token, "Found unneeded semicolon");
+				syntax_error(prev_token, "Found unneeded semicolon");
 			} else if (build_context.strict_style_init_only && f->pkg->kind == Package_Init) {
-				syntax_error(*prev_token, "Found unneeded semicolon");
+				syntax_error(prev_token, "Found unneeded semicolon");
 			}
-			prev_token->flags |= TokenFlag_Remove;
+			f->tokens[f->prev_token_index].flags |= TokenFlag_Remove;
 		}
 	}
 }
@@ -1901,7 +2079,7 @@ Ast *convert_stmt_to_expr(AstFile *f, Ast *statement, String const &kind) {
 	syntax_error(f->curr_token, "Expected '%.*s', found a simple statement.", LIT(kind));
 	Token end = f->curr_token;
 	if (f->tokens.count < f->curr_token_index) {
-		end = f->tokens[f->curr_token_index+1];
+		end = ast_file_token(f, f->curr_token_index+1);
 	}
 	return ast_bad_expr(f, f->curr_token, end);
 }
@@ -2254,6 +2432,7 @@ Ast *parse_operand(AstFile *f, bool lhs) {
 		}
 
 
+		u32 node_begin = ast_file_node_block_used(f);
 		Ast *type = parse_proc_type(f, token);
 		Token where_token = {};
 		Array<Ast *> where_clauses = {};
@@ -2294,7 +2473,7 @@ Ast *parse_operand(AstFile *f, bool lhs) {
 			if (where_token.kind != Token_Invalid) {
 				syntax_error(where_token, "'where' clauses are not allowed on procedure literals without a defined body (replaced with ---)");
 			}
-			return ast_proc_lit(f, type, nullptr, tags, where_token, where_clauses);
+			return ast_proc_lit(f, type, nullptr, tags, where_token, where_clauses, node_begin);
 		} else if (f->curr_token.kind == Token_OpenBrace) {
 			Ast *curr_proc = f->curr_proc;
 			Ast *body = nullptr;
@@ -2316,7 +2495,7 @@ Ast *parse_operand(AstFile *f, bool lhs) {
 				body->state_flags |= StateFlag_type_assert;
 			}
 
-			return ast_proc_lit(f, type, body, tags, where_token, where_clauses);
+			return ast_proc_lit(f, type, body, tags, where_token, where_clauses, node_begin);
 		} else if (allow_token(f, Token_do)) {
 			Ast *curr_proc = f->curr_proc;
 			Ast *body = nullptr;
@@ -2326,7 +2505,7 @@ Ast *parse_operand(AstFile *f, bool lhs) {
 
 			syntax_error(body, "'do' for procedure bodies is not allowed, prefer {}");
 
-			return ast_proc_lit(f, type, body, tags, where_token, where_clauses);
+			return ast_proc_lit(f, type, body, tags, where_token, where_clauses, node_begin);
 		}
 
 		if (tags != 0) {
@@ -4092,7 +4271,7 @@ Ast *parse_if_stmt(AstFile *f) {
 			break;
 		default:
 			syntax_error(f->curr_token, "Expected if statement block statement");
-			else_stmt = ast_bad_stmt(f, f->curr_token, f->tokens[f->curr_token_index+1]);
+			else_stmt = ast_bad_stmt(f, f->curr_token, ast_file_token(f, f->curr_token_index+1));
 			break;
 		}
 	}
@@ -4139,7 +4318,7 @@ Ast *parse_when_stmt(AstFile *f) {
 		} break;
 		default:
 			syntax_error(f->curr_token, "Expected when statement block statement");
-			else_stmt = ast_bad_stmt(f, f->curr_token, f->tokens[f->curr_token_index+1]);
+			else_stmt = ast_bad_stmt(f, f->curr_token, ast_file_token(f, f->curr_token_index+1));
 			break;
 		}
 	}
@@ -4828,29 +5007,40 @@ ParseFileError init_ast_file(AstFile *f, String const &fullpath, TokenPos *err_p
 	isize init_token_cap = gb_max(token_cap, 16);
 	array_init(&f->tokens, heap_allocator(), 0, gb_max(init_token_cap, 16));
 
+	array_init(&f->line_offsets, heap_allocator(), 0, gb_max(file_size/32, 16));
+	array_add(&f->line_offsets, 0);
+
 	if (err == TokenizerInit_Empty) {
 		Token token = {Token_EOF};
-		token.pos.file_id = f->id;
-		token.pos.line    = 1;
-		token.pos.column  = 1;
-		array_add(&f->tokens, token);
+		array_add(&f->tokens, make_compact_token(token));
 		return ParseFile_None;
 	}
 
 	u64 start = time_stamp_time_now();
 
 	for (;;) {
-		Token *token = array_add_and_get(&f->tokens);
-		tokenizer_get_token(&f->tokenizer, token);
-		if (token->kind == Token_Invalid) {
-			err_pos->line   = token->pos.line;
-			err_pos->column = token->pos.column;
+		Token token = {};
+		tokenizer_get_token(&f->tokenizer, &token);
+		if (token.kind == Token_Invalid) {
+			err_pos->line   = token.pos.line;
+			err_pos->column = token.pos.column;
 			return ParseFile_InvalidToken;
 		}
+		array_add(&f->tokens, make_compact_token(token));
+
+		if (token.kind == Token_EOF) {
+			break;
+		}
+	}
 
-		if (token->kind == Token_EOF) {
+	u8 const *data = f->tokenizer.start;
+	for (isize offset = 0; offset < file_size; /**/) {
+		u8 const *newline = cast(u8 const *)memchr(data+offset, '\n', file_size-offset);
+		if (newline == nullptr) {
 			break;
 		}
+		offset = newline+1 - data;
+		array_add(&f->line_offsets, cast(i32)offset);
 	}
 
 	u64 end = time_stamp_time_now();
@@ -4858,8 +5048,8 @@ ParseFileError init_ast_file(AstFile *f, String const &fullpath, TokenPos *err_p
 
 	f->prev_token_index = 0;
 	f->curr_token_index = 0;
-	f->prev_token = f->tokens[f->prev_token_index];
-	f->curr_token = f->tokens[f->curr_token_index];
+	f->curr_token = ast_file_token_sequential(f, f->curr_token_index);
+	f->prev_token = f->curr_token;
 
 	array_init(&f->comments, heap_allocator(), 0, 0);
 	array_init(&f->imports,  heap_allocator(), 0, 0);
@@ -4872,6 +5062,7 @@ ParseFileError init_ast_file(AstFile *f, String const &fullpath, TokenPos *err_p
 void destroy_ast_file(AstFile *f) {
 	GB_ASSERT(f != nullptr);
 	array_free(&f->tokens);
+	array_free(&f->line_offsets);
 	array_free(&f->comments);
 	array_free(&f->imports);
 }
@@ -5514,6 +5705,14 @@ bool parse_file(Parser *p, AstFile *f) {
 
 	u64 start = time_stamp_time_now();
 
+	f->node_block = virtual_memory_alloc(align_formula_isize(f->tokens.count*AST_FILE_NODE_BLOCK_BYTES_PER_TOKEN, DEFAULT_PAGE_SIZE));
+	global_thread_local_parsing_ast_file = f;
+	defer ({
+		global_thread_local_parsing_ast_file = nullptr;
+		global_total_node_block_memory_used += f->node_block->used;
+		global_total_node_block_memory_reserved += f->node_block->size;
+	});
+
 	String filepath = f->tokenizer.fullpath;
 	String base_dir = dir_from_path(filepath);
 	if (f->curr_token.kind == Token_Comment) {
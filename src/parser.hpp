@@ -101,7 +101,9 @@ struct AstFile {
 	Ast *        pkg_decl;
 	String       fullpath;
 	Tokenizer    tokenizer;
-	Array<Token> tokens;
+	Array<CompactToken> tokens;
+	Array<i32>   line_offsets; // offset of the start of each line
+	TokenPos     token_pos_cursor; // position of the last token recovered with `ast_file_token_sequential`
 	isize        curr_token_index;
 	isize        prev_token_index;
 	Token        curr_token;
@@ -144,6 +146,8 @@ struct AstFile {
 	isize    fix_count;
 	TokenPos fix_prev_pos;
 
+	MemoryBlock *node_block; // nodes allocated while parsing this file, see `alloc_ast_node`
+
 	struct LLVMOpaqueMetadata *llvm_metadata;
 	struct LLVMOpaqueMetadata *llvm_metadata_scope;
 };
@@ -347,6 +351,7 @@ enum UnionTypeKind : u8 {
 	AST_KIND(Ident,          "identifier",      struct { \
 		Token   token;  \
 		Entity *entity; \
+		u32     hash;   \
 	}) \
 	AST_KIND(Implicit,       "implicit",        Token) \
 	AST_KIND(Undef,          "undef",           Token) \
@@ -375,6 +380,7 @@ enum UnionTypeKind : u8 {
 		Token where_token; \
 		Slice<Ast *> where_clauses; \
 		DeclInfo *decl; \
+		u32 node_begin, node_end; /* offsets of all of its nodes in the file's node block, see `clone_ast` */ \
 	}) \
 	AST_KIND(CompoundLit, "compound literal", struct { \
 		Ast *type; \
@@ -752,15 +758,22 @@ struct AstCommonStuff {
 	u8           state_flags;
 	u8           viral_state_flags;
 	i32          file_id;
-	TypeAndValue tav; // TODO(bill): Make this a pointer to minimize 'Ast' size
 };
 
+// NOTE: Only expressions and types can have a 'TypeAndValue', so only those nodes allocate one,
+// and it is stored directly before the node itself (see 'alloc_ast_node')
+gb_inline bool ast_kind_has_type_and_value(AstKind kind) {
+	return gb_is_between(kind, Ast_Invalid+1, Ast__StmtBegin-1) ||
+	       gb_is_between(kind, Ast__TypeBegin+1, Ast__TypeEnd-1);
+}
+
+gb_global TypeAndValue const empty_type_and_value = {};
+
 struct Ast {
 	AstKind      kind; // u16
 	u8           state_flags;
 	u8           viral_state_flags;
 	i32          file_id;
-	TypeAndValue tav; // TODO(bill): Make this a pointer to minimize 'Ast' size
 
 	// IMPORTANT NOTE(bill): This must be at the end since the AST is allocated to be size of the variant
 	union {
@@ -779,6 +792,17 @@ struct Ast {
 	gb_inline AstFile *thread_safe_file() const {
 		return thread_safe_get_ast_file_from_id(this->file_id);
 	}
+
+	gb_inline TypeAndValue const &tav() const {
+		if (!ast_kind_has_type_and_value(this->kind)) {
+			return empty_type_and_value;
+		}
+		return (cast(TypeAndValue const *)this)[-1];
+	}
+	gb_inline TypeAndValue &mutable_tav() {
+		GB_ASSERT_MSG(ast_kind_has_type_and_value(this->kind), "'%.*s' cannot have a type and value", LIT(ast_strings[this->kind]));
+		return (cast(TypeAndValue *)this)[-1];
+	}
 };
 
 
@@ -810,13 +834,48 @@ gb_inline bool is_ast_when_stmt(Ast *node) {
 	return node->kind == Ast_WhenStmt;
 }
 
-gb_global gb_thread_local Arena global_thread_local_ast_arena = {};
+// NOTE: A thread only ever parses one file at a time, so the nodes of a file are laid out
+// contiguously in this arena. The arena is thread local, so it does not need the global mutex.
+gb_global gb_thread_local Arena global_thread_local_ast_arena = {nullptr, DEFAULT_MINIMUM_BLOCK_SIZE, true};
 
 gbAllocator ast_allocator(AstFile *f) {
 	Arena *arena = &global_thread_local_ast_arena;
 	return arena_allocator(arena);
 }
 
+// NOTE: While a file is being parsed, its nodes are allocated from a single contiguous block owned
+// by that file rather than from the thread local arena. A node in it can be referred to by its 32-bit
+// offset, and the nodes of a procedure literal can be copied all at once (see `clone_ast`).
+// Nodes allocated after parsing, or once the block is full, still come from `ast_allocator`.
+gb_global gb_thread_local AstFile *global_thread_local_parsing_ast_file;
+
+enum { AST_FILE_NODE_BLOCK_BYTES_PER_TOKEN = 128 };
+
+gb_inline u32 ast_file_node_block_used(AstFile *f) {
+	if (f == nullptr || f->node_block == nullptr) {
+		return 0;
+	}
+	return cast(u32)f->node_block->used;
+}
+
+gb_inline bool ast_file_owns_node(AstFile *f, Ast *node) {
+	if (f == nullptr || f->node_block == nullptr) {
+		return false;
+	}
+	u8 *ptr = cast(u8 *)node;
+	return f->node_block->base <= ptr && ptr < f->node_block->base + f->node_block->used;
+}
+
+gb_inline u32 ast_file_node_offset(AstFile *f, Ast *node) {
+	GB_ASSERT(ast_file_owns_node(f, node));
+	return cast(u32)(cast(u8 *)node - f->node_block->base);
+}
+
+gb_inline Ast *ast_file_node(AstFile *f, u32 offset) {
+	GB_ASSERT(f->node_block != nullptr && offset < f->node_block->used);
+	return cast(Ast *)(f->node_block->base + offset);
+}
+
 Ast *alloc_ast_node(AstFile *f, AstKind kind);
 
 gbString expr_to_string(Ast *expression);
@@ -124,6 +124,37 @@ i32 mpmc_enqueue(MPMCQueue<T> *q, T const &data) {
 	}
 }
 
+// NOTE: Unlike `mpmc_enqueue`, this never grows the queue and fails when it is full,
+// so it is safe to use concurrently with `mpmc_dequeue`
+template <typename T>
+bool mpmc_try_enqueue(MPMCQueue<T> *q, T const &data) {
+	GB_ASSERT(q->mask != 0);
+
+	i32 head_idx = q->head_idx.load(std::memory_order_relaxed);
+
+	for (;;) {
+		i32 index = head_idx & q->mask;
+		auto node = &q->nodes[index];
+		auto node_idx_ptr = &q->indices[index];
+		i32 node_idx = node_idx_ptr->load(std::memory_order_acquire);
+		i32 diff = node_idx - head_idx;
+
+		if (diff == 0) {
+			i32 next_head_idx = head_idx+1;
+			if (q->head_idx.compare_exchange_weak(head_idx, next_head_idx)) {
+				*node = data;
+				node_idx_ptr->store(next_head_idx, std::memory_order_release);
+				q->count.fetch_add(1, std::memory_order_release);
+				return true;
+			}
+		} else if (diff < 0) {
+			return false;
+		} else {
+			head_idx = q->head_idx.load(std::memory_order_relaxed);
+		}
+	}
+}
+
 template <typename T>
 bool mpmc_dequeue(MPMCQueue<T> *q, T *data_) {
 	if (q->mask == 0) {
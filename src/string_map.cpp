@@ -13,6 +13,10 @@ gb_inline StringHashKey string_hash_string(String const &s) {
 
 bool string_hash_key_equal(StringHashKey const &a, StringHashKey const &b) {
 	if (a.hash == b.hash) {
+		if (a.string.text == b.string.text) {
+			// NOTE: Interned strings (e.g. identifiers) share the same memory
+			return a.string.len == b.string.len;
+		}
 		// NOTE(bill): If two string's hashes collide, compare the strings themselves
 		return a.string == b.string;
 	}
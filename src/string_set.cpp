@@ -48,7 +48,7 @@ gb_internal MapIndex string_set__add_entry(StringSet *s, StringHashKey const &ke
 gb_internal MapFindResult string_set__find(StringSet *s, StringHashKey const &key) {
 	MapFindResult fr = {MAP_SENTINEL, MAP_SENTINEL, MAP_SENTINEL};
 	if (s->hashes.count > 0) {
-		fr.hash_index = cast(MapIndex)(((u64)key.hash) % s->hashes.count);
+		fr.hash_index = cast(MapIndex)(key.hash & (s->hashes.count-1));
 		fr.entry_index = s->hashes[fr.hash_index];
 		while (fr.entry_index != MAP_SENTINEL) {
 			auto const &entry = s->entries[fr.entry_index];
@@ -64,7 +64,7 @@ gb_internal MapFindResult string_set__find(StringSet *s, StringHashKey const &ke
 gb_internal MapFindResult string_set__find_from_entry(StringSet *s, StringSetEntry *e) {
 	MapFindResult fr = {MAP_SENTINEL, MAP_SENTINEL, MAP_SENTINEL};
 	if (s->hashes.count > 0) {
-		fr.hash_index = cast(MapIndex)(e->hash % s->hashes.count);
+		fr.hash_index = cast(MapIndex)(e->hash & (s->hashes.count-1));
 		fr.entry_index = s->hashes[fr.hash_index];
 		while (fr.entry_index != MAP_SENTINEL) {
 			if (&s->entries[fr.entry_index] == e) {
@@ -4,11 +4,15 @@
 typedef WORKER_TASK_PROC(WorkerTaskProc);
 
 struct WorkerTask {
-	WorkerTask *    next;
 	WorkerTaskProc *do_work;
 	void *          data;
 };
 
+// NOTE: Tasks are stored by value in a fixed size ring, so submitting a task normally never allocates
+// and never takes `mutex`. The ring is never grown, as that cannot be done safely while other threads
+// are dequeuing; once it is full, tasks go to `overflow_tasks` under `mutex` instead.
+#define THREAD_POOL_TASK_QUEUE_SIZE (1<<16)
+
 struct ThreadPool {
 	gbAllocator   allocator;
 	BlockingMutex mutex;
@@ -16,9 +20,12 @@ struct ThreadPool {
 	
 	Slice<Thread> threads;
 	
-	WorkerTask *task_queue;
+	MPMCQueue<WorkerTask> task_queue;
+	Array<WorkerTask>     overflow_tasks; // guarded by `mutex`
+	std::atomic<isize>    overflow_count;
 	
 	std::atomic<isize> ready;
+	std::atomic<isize> sleeping;
 	std::atomic<bool>  stop;
 	
 };
@@ -28,8 +35,12 @@ THREAD_PROC(thread_pool_thread_proc);
 void thread_pool_init(ThreadPool *pool, gbAllocator const &a, isize thread_count, char const *worker_name) {
 	pool->allocator = a;
 	pool->stop = false;
+	pool->sleeping = 0;
 	mutex_init(&pool->mutex);
 	condition_init(&pool->task_cond);
+	mpmc_init(&pool->task_queue, heap_allocator(), THREAD_POOL_TASK_QUEUE_SIZE);
+	array_init(&pool->overflow_tasks, heap_allocator());
+	pool->overflow_count = 0;
 	
 	slice_init(&pool->threads, a, thread_count);
 	for_array(i, pool->threads) {
@@ -60,43 +71,66 @@ void thread_pool_destroy(ThreadPool *pool) {
 	}
 	
 	gb_free(pool->allocator, pool->threads.data);
+	mpmc_destroy(&pool->task_queue);
+	array_free(&pool->overflow_tasks);
 	mutex_destroy(&pool->mutex);
 	condition_destroy(&pool->task_cond);
 }
 
 bool thread_pool_queue_empty(ThreadPool *pool) {
-	return pool->task_queue == nullptr;
+	return pool->task_queue.count.load() <= 0 && pool->overflow_count.load() == 0;
 }
 
-WorkerTask *thread_pool_queue_pop(ThreadPool *pool) {
-	GB_ASSERT(pool->task_queue != nullptr);
-	WorkerTask *task = pool->task_queue;
-	pool->task_queue = task->next;
-	return task;
+bool thread_pool_queue_pop(ThreadPool *pool, WorkerTask *task) {
+	if (mpmc_dequeue(&pool->task_queue, task)) {
+		return true;
+	}
+	if (pool->overflow_count.load() == 0) {
+		return false;
+	}
+	mutex_lock(&pool->mutex);
+	bool ok = pool->overflow_tasks.count > 0;
+	if (ok) {
+		*task = array_pop(&pool->overflow_tasks);
+		pool->overflow_count.fetch_sub(1);
+	}
+	mutex_unlock(&pool->mutex);
+	return ok;
 }
-void thread_pool_queue_push(ThreadPool *pool, WorkerTask *task) {
-	GB_ASSERT(task != nullptr);
-	task->next = pool->task_queue;
-	pool->task_queue = task;
+
+// NOTE: Must be called with `mutex` held. The caller is registered as sleeping before the queue
+// is checked, so that a concurrent `thread_pool_add_task` either sees it and signals, or the caller
+// sees the new task and does not wait.
+void thread_pool_sleep_while(ThreadPool *pool, bool wait_for_ready) {
+	pool->sleeping.fetch_add(1);
+	while (!pool->stop && thread_pool_queue_empty(pool) && (!wait_for_ready || pool->ready > 0)) {
+		condition_wait(&pool->task_cond, &pool->mutex);
+	}
+	pool->sleeping.fetch_sub(1);
 }
 
 bool thread_pool_add_task(ThreadPool *pool, WorkerTaskProc *proc, void *data) {
 	GB_ASSERT(proc != nullptr);
-	mutex_lock(&pool->mutex);
-	WorkerTask *task = gb_alloc_item(permanent_allocator(), WorkerTask);
-	if (task == nullptr) {
-		mutex_unlock(&pool->mutex);
-		GB_PANIC("Out of memory");
-		return false;
-	}
-	task->do_work = proc;
-	task->data = data;
-		
-	thread_pool_queue_push(pool, task);
+	WorkerTask task = {};
+	task.do_work = proc;
+	task.data = data;
+
 	GB_ASSERT(pool->ready >= 0);
 	pool->ready++;
-	condition_broadcast(&pool->task_cond);
-	mutex_unlock(&pool->mutex);
+	if (!mpmc_try_enqueue(&pool->task_queue, task)) {
+		mutex_lock(&pool->mutex);
+		array_add(&pool->overflow_tasks, task);
+		pool->overflow_count.fetch_add(1);
+		mutex_unlock(&pool->mutex);
+	}
+
+	// NOTE: Only wake a single thread for a single task, and only if one is actually asleep
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (pool->sleeping.load() > 0) {
+		mutex_lock(&pool->mutex);
+		condition_signal(&pool->task_cond);
+		mutex_unlock(&pool->mutex);
+	}
 	return true;
 }	
 
@@ -105,34 +139,37 @@ void thread_pool_do_task(WorkerTask *task) {
 	task->do_work(task->data);
 }
 
+void thread_pool_task_done(ThreadPool *pool) {
+	if (--pool->ready == 0) {
+		mutex_lock(&pool->mutex);
+		condition_broadcast(&pool->task_cond);
+		mutex_unlock(&pool->mutex);
+	}
+}
+
 void thread_pool_wait(ThreadPool *pool) {
+	WorkerTask task = {};
 	if (pool->threads.count == 0) {
-		while (!thread_pool_queue_empty(pool)) {
-			thread_pool_do_task(thread_pool_queue_pop(pool));
+		while (thread_pool_queue_pop(pool, &task)) {
+			thread_pool_do_task(&task);
 			--pool->ready;
 		}
 		GB_ASSERT(pool->ready == 0);
 		return;
 	}
 	for (;;) {
-		mutex_lock(&pool->mutex);
-
-		while (!pool->stop && pool->ready > 0 && thread_pool_queue_empty(pool)) {
-			condition_wait(&pool->task_cond, &pool->mutex);
-		}
-		if ((pool->stop || pool->ready == 0) && thread_pool_queue_empty(pool)) {
-			mutex_unlock(&pool->mutex);
-			return;
+		if (thread_pool_queue_pop(pool, &task)) {
+			thread_pool_do_task(&task);
+			thread_pool_task_done(pool);
+			continue;
 		}
 
-		WorkerTask *task = thread_pool_queue_pop(pool);
+		mutex_lock(&pool->mutex);
+		thread_pool_sleep_while(pool, true);
+		bool done = (pool->stop || pool->ready == 0) && thread_pool_queue_empty(pool);
 		mutex_unlock(&pool->mutex);
-	
-		thread_pool_do_task(task);
-		if (--pool->ready == 0) {
-			mutex_lock(&pool->mutex);
-			condition_broadcast(&pool->task_cond);
-			mutex_unlock(&pool->mutex);
+		if (done) {
+			return;
 		}
 	}
 }
@@ -140,26 +177,21 @@ void thread_pool_wait(ThreadPool *pool) {
 
 THREAD_PROC(thread_pool_thread_proc) {
 	ThreadPool *pool = cast(ThreadPool *)thread->user_data;
+	WorkerTask task = {};
 	
 	for (;;) {
-		mutex_lock(&pool->mutex);
-
-		while (!pool->stop && thread_pool_queue_empty(pool)) {
-			condition_wait(&pool->task_cond, &pool->mutex);
-		}
-		if (pool->stop && thread_pool_queue_empty(pool)) {
-			mutex_unlock(&pool->mutex);
-			return 0;
+		if (thread_pool_queue_pop(pool, &task)) {
+			thread_pool_do_task(&task);
+			thread_pool_task_done(pool);
+			continue;
 		}
 
-		WorkerTask *task = thread_pool_queue_pop(pool);
+		mutex_lock(&pool->mutex);
+		thread_pool_sleep_while(pool, false);
+		bool done = pool->stop && thread_pool_queue_empty(pool);
 		mutex_unlock(&pool->mutex);
-	
-		thread_pool_do_task(task);
-		if (--pool->ready == 0) {
-			mutex_lock(&pool->mutex);
-			condition_broadcast(&pool->task_cond);
-			mutex_unlock(&pool->mutex);
+		if (done) {
+			return 0;
 		}
 	}
-}
\ No newline at end of file
+}
@@ -240,6 +240,28 @@ struct Token {
 	TokenPos  pos;
 };
 
+// NOTE: The form in which the tokens of a file are stored. The string and line of a token are
+// recovered from the file's data and line offsets when needed (see `ast_file_token`), and the column is
+// kept from the tokenizer as it would otherwise need the runes of the line to be counted
+struct CompactToken {
+	u8  kind;
+	u8  flags;
+	u16 column; // 0 if it does not fit
+	i32 offset;
+	i32 len;
+};
+GB_STATIC_ASSERT(Token_Count <= 256);
+
+CompactToken make_compact_token(Token const &token) {
+	CompactToken ct = {};
+	ct.kind   = cast(u8)token.kind;
+	ct.flags  = token.flags;
+	ct.column = token.pos.column <= cast(i32)U16_MAX ? cast(u16)token.pos.column : 0;
+	ct.offset = token.pos.offset;
+	ct.len    = cast(i32)token.string.len;
+	return ct;
+}
+
 Token empty_token = {Token_Invalid};
 Token blank_token = {Token_Ident, 0, {cast(u8 *)"_", 1}};
 
@@ -289,6 +311,11 @@ enum TokenizerInitError {
 	TokenizerInit_Count,
 };
 
+#if defined(GB_CPU_X86) && (defined(GB_ARCH_64_BIT) || defined(__SSE2__))
+#include <emmintrin.h>
+#define TOKENIZER_USE_SSE2 1
+#endif
+
 struct Tokenizer {
 	i32 curr_file_id;
 	String fullpath;
@@ -342,11 +369,7 @@ void tokenizer_err(Tokenizer *t, TokenPos const &pos, char const *msg, ...) {
 	t->error_count++;
 }
 
-void advance_to_next_rune(Tokenizer *t) {
-	if (t->curr_rune == '\n') {
-		t->column_minus_one = -1;
-		t->line_count++;
-	}
+gb_inline void tokenizer_read_rune(Tokenizer *t) {
 	if (t->read_curr < t->end) {
 		t->curr = t->read_curr;
 		Rune rune = *t->read_curr;
@@ -372,9 +395,18 @@ void advance_to_next_rune(Tokenizer *t) {
 	}
 }
 
+void advance_to_next_rune(Tokenizer *t) {
+	if (t->curr_rune == '\n') {
+		t->column_minus_one = -1;
+		t->line_count++;
+	}
+	tokenizer_read_rune(t);
+}
+
 void init_tokenizer_with_data(Tokenizer *t, String const &fullpath, void const *data, isize size) {
 	t->fullpath = fullpath;
 	t->line_count = 1;
+	t->column_minus_one = -1;
 
 	t->start = cast(u8 *)data;
 	t->read_curr = t->curr = t->start;
@@ -396,6 +428,8 @@ TokenizerInitError loaded_file_error_map_to_tokenizer[LoadedFile_COUNT] = {
 };
 
 TokenizerInitError init_tokenizer_from_fullpath(Tokenizer *t, String const &fullpath, bool copy_file_contents) {
+	TEMPORARY_ALLOCATOR_GUARD();
+
 	LoadedFileError file_err = load_file_32(
 		alloc_cstring(temporary_allocator(), fullpath), 
 		&t->loaded_file,
@@ -633,13 +667,153 @@ bool scan_escape(Tokenizer *t) {
 }
 
 
+enum TokenizerRunKind {
+	TokenizerRun_Identifier,        // [A-Za-z0-9_]
+	TokenizerRun_Whitespace,        // ' ' '\t' '\r'
+	TokenizerRun_WhitespaceNewline, // ' ' '\t' '\r' '\n'
+	TokenizerRun_LineComment,       // anything but '\n'
+	TokenizerRun_BlockComment,      // anything but '/' '*'
+	TokenizerRun_String,            // anything but '"' '\\' '\n'
+	TokenizerRun_RawString,         // anything but '`' '\r'
+};
+
+// NOTE: NUL and non-ASCII bytes never belong to a run, so they are always
+// decoded and validated by `advance_to_next_rune`
+gb_inline bool tokenizer_is_run_byte(TokenizerRunKind kind, u8 c) {
+	if (c == 0 || c >= 0x80) {
+		return false;
+	}
+	switch (kind) {
+	case TokenizerRun_Identifier:
+		return ('a' <= (c|0x20) && (c|0x20) <= 'z') || ('0' <= c && c <= '9') || c == '_';
+	case TokenizerRun_Whitespace:
+		return c == ' ' || c == '\t' || c == '\r';
+	case TokenizerRun_WhitespaceNewline:
+		return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+	case TokenizerRun_LineComment:
+		return c != '\n';
+	case TokenizerRun_BlockComment:
+		return c != '/' && c != '*';
+	case TokenizerRun_String:
+		return c != '"' && c != '\\' && c != '\n';
+	case TokenizerRun_RawString:
+		return c != '`' && c != '\r';
+	}
+	return false;
+}
+
+#if defined(TOKENIZER_USE_SSE2)
+gb_inline u32 tokenizer_eq_mask_sse2(__m128i v, char c) {
+	return cast(u32)_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8(c)));
+}
+
+gb_inline u32 tokenizer_range_mask_sse2(__m128i v, char lo, char hi) {
+	// NOTE: Signed comparisons, so non-ASCII bytes (negative) are never within the range
+	__m128i ge = _mm_cmpgt_epi8(v, _mm_set1_epi8(lo-1));
+	__m128i le = _mm_cmplt_epi8(v, _mm_set1_epi8(hi+1));
+	return cast(u32)_mm_movemask_epi8(_mm_and_si128(ge, le));
+}
+
+// Returns a mask of the bytes in the block which belong to a run of `kind`
+gb_inline u32 tokenizer_run_mask_sse2(TokenizerRunKind kind, __m128i v) {
+	u32 ascii = ~cast(u32)_mm_movemask_epi8(v) & 0xffff;
+	u32 nul = tokenizer_eq_mask_sse2(v, 0);
+	switch (kind) {
+	case TokenizerRun_Identifier: {
+		__m128i lower = _mm_or_si128(v, _mm_set1_epi8(0x20));
+		return tokenizer_range_mask_sse2(lower, 'a', 'z') |
+		       tokenizer_range_mask_sse2(v, '0', '9') |
+		       tokenizer_eq_mask_sse2(v, '_');
+	}
+	case TokenizerRun_Whitespace:
+		return tokenizer_eq_mask_sse2(v, ' ') | tokenizer_eq_mask_sse2(v, '\t') | tokenizer_eq_mask_sse2(v, '\r');
+	case TokenizerRun_WhitespaceNewline:
+		return tokenizer_eq_mask_sse2(v, ' ') | tokenizer_eq_mask_sse2(v, '\t') | tokenizer_eq_mask_sse2(v, '\r') |
+		       tokenizer_eq_mask_sse2(v, '\n');
+	case TokenizerRun_LineComment:
+		return ascii & ~(nul | tokenizer_eq_mask_sse2(v, '\n'));
+	case TokenizerRun_BlockComment:
+		return ascii & ~(nul | tokenizer_eq_mask_sse2(v, '/') | tokenizer_eq_mask_sse2(v, '*'));
+	case TokenizerRun_String:
+		return ascii & ~(nul | tokenizer_eq_mask_sse2(v, '"') | tokenizer_eq_mask_sse2(v, '\\') | tokenizer_eq_mask_sse2(v, '\n'));
+	case TokenizerRun_RawString:
+		return ascii & ~(nul | tokenizer_eq_mask_sse2(v, '`') | tokenizer_eq_mask_sse2(v, '\r'));
+	}
+	return 0;
+}
+#endif
+
+// NOTE: Skips the run of ASCII bytes of `kind` starting at the current rune, 16 bytes at a
+// time where possible, leaving the tokenizer on the first rune after the run
+void tokenizer_skip_run(Tokenizer *t, TokenizerRunKind kind) {
+	u8 *start = t->curr;
+	u8 *end   = t->end;
+	u8 *p     = start;
+
+	i32 newline_count = 0;
+	u8 *last_newline  = nullptr;
+
+#if defined(TOKENIZER_USE_SSE2)
+	while (end - p >= 16) {
+		__m128i v = _mm_loadu_si128(cast(__m128i const *)p);
+		u32 in_run = tokenizer_run_mask_sse2(kind, v);
+		u32 not_in_run = ~in_run & 0xffff;
+		// NOTE: Only the bytes before the first byte which is not in the run
+		u32 run_mask = not_in_run ? (not_in_run & (0u-not_in_run)) - 1 : 0xffff;
+
+		u32 newlines = tokenizer_eq_mask_sse2(v, '\n') & run_mask;
+		if (newlines) {
+			newline_count += bit_set_count(newlines);
+			last_newline = p + floor_log2(newlines);
+		}
+		if (not_in_run) {
+			p += bit_set_count(run_mask);
+			goto run_end;
+		}
+		p += 16;
+	}
+#endif
+
+	for (; p < end; p++) {
+		u8 c = *p;
+		if (!tokenizer_is_run_byte(kind, c)) {
+			break;
+		}
+		if (c == '\n') {
+			newline_count++;
+			last_newline = p;
+		}
+	}
+
+#if defined(TOKENIZER_USE_SSE2)
+run_end:;
+#endif
+	if (p == start) {
+		return;
+	}
+
+	t->line_count += newline_count;
+	if (newline_count > 0) {
+		t->column_minus_one = cast(i32)(p - (last_newline+1)) - 1;
+	} else {
+		t->column_minus_one += cast(i32)(p - start) - 1;
+	}
+	t->read_curr = p;
+	tokenizer_read_rune(t);
+}
+
 gb_inline void tokenizer_skip_line(Tokenizer *t) {
-	while (t->curr_rune != '\n' && t->curr_rune != GB_RUNE_EOF) {
+	for (;;) {
+		tokenizer_skip_run(t, TokenizerRun_LineComment);
+		if (t->curr_rune == '\n' || t->curr_rune == GB_RUNE_EOF) {
+			break;
+		}
 		advance_to_next_rune(t);
 	}
 }
 
 gb_inline void tokenizer_skip_whitespace(Tokenizer *t, bool on_newline) {
+	tokenizer_skip_run(t, on_newline ? TokenizerRun_Whitespace : TokenizerRun_WhitespaceNewline);
 	if (on_newline) {
 		for (;;) {
 			switch (t->curr_rune) {
@@ -682,7 +856,11 @@ void tokenizer_get_token(Tokenizer *t, Token *token, int repeat=0) {
 	Rune curr_rune = t->curr_rune;
 	if (rune_is_letter(curr_rune)) {
 		token->kind = Token_Ident;
-		while (rune_is_letter_or_digit(t->curr_rune)) {
+		for (;;) {
+			tokenizer_skip_run(t, TokenizerRun_Identifier);
+			if (!rune_is_letter_or_digit(t->curr_rune)) {
+				break;
+			}
 			advance_to_next_rune(t);
 		}
 
@@ -780,6 +958,7 @@ void tokenizer_get_token(Tokenizer *t, Token *token, int repeat=0) {
 			token->kind = Token_String;
 			if (curr_rune == '"') {
 				for (;;) {
+					tokenizer_skip_run(t, TokenizerRun_String);
 					Rune r = t->curr_rune;
 					if (r == '\n' || r < 0) {
 						tokenizer_err(t, "String literal not terminated");
@@ -795,6 +974,7 @@ void tokenizer_get_token(Tokenizer *t, Token *token, int repeat=0) {
 				}
 			} else {
 				for (;;) {
+					tokenizer_skip_run(t, TokenizerRun_RawString);
 					Rune r = t->curr_rune;
 					if (r < 0) {
 						tokenizer_err(t, "String literal not terminated");
@@ -944,6 +1124,7 @@ void tokenizer_get_token(Tokenizer *t, Token *token, int repeat=0) {
 				token->kind = Token_Comment;
 				advance_to_next_rune(t);
 				for (isize comment_scope = 1; comment_scope > 0; /**/) {
+					tokenizer_skip_run(t, TokenizerRun_BlockComment);
 					if (t->curr_rune == GB_RUNE_EOF) {
 						break;
 					} else if (t->curr_rune == '/') {
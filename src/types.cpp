@@ -808,8 +808,103 @@ void type_path_pop(TypePath *tp) {
 #define FAILURE_SIZE      0
 #define FAILURE_ALIGNMENT 0
 
+// NOTE: Composite types which are built purely from their component types (pointers, slices, arrays, etc)
+// are hash-consed, so that identical types built from the same component types share the same 'Type *'.
+// This means pointer equality is the fast path for type identity and 'PtrMap<Type *, ...>' caches hit far more often
+enum {TYPE_INTERN_SHARD_COUNT = 32};
+
+struct TypeInternShard {
+	BlockingMutex mutex;
+	PtrMap<uintptr, Type *> map; // multi-map
+};
+
+gb_global TypeInternShard g_type_intern_shards[TYPE_INTERN_SHARD_COUNT];
+gb_global std::atomic<bool> g_type_intern_initialized;
+
 void init_type_mutex(void) {
 	mutex_init(&g_type_mutex);
+
+	for (isize i = 0; i < TYPE_INTERN_SHARD_COUNT; i++) {
+		TypeInternShard *shard = &g_type_intern_shards[i];
+		mutex_init(&shard->mutex);
+		map_init(&shard->map, heap_allocator());
+	}
+	g_type_intern_initialized.store(true);
+}
+
+u64 type_intern_hash(TypeKind kind, Type *a, Type *b, i64 count) {
+	u64 h = cast(u64)kind;
+	h = h*0x100000001b3ull ^ cast(u64)cast(uintptr)a;
+	h = h*0x100000001b3ull ^ cast(u64)cast(uintptr)b;
+	h = h*0x100000001b3ull ^ cast(u64)count;
+	h ^= h >> 29;
+	h *= 0xbf58476d1ce4e5b9ull;
+	h ^= h >> 32;
+	return h;
+}
+
+bool type_intern_matches(Type *t, TypeKind kind, Type *a, Type *b, i64 count) {
+	if (t->kind != kind) {
+		return false;
+	}
+	switch (kind) {
+	case Type_Pointer:      return t->Pointer.elem == a;
+	case Type_MultiPointer: return t->MultiPointer.elem == a;
+	case Type_Slice:        return t->Slice.elem == a;
+	case Type_DynamicArray: return t->DynamicArray.elem == a;
+	case Type_Array:        return t->Array.elem == a && t->Array.count == count && t->Array.generic_count == nullptr;
+	case Type_Map:          return t->Map.key == a && t->Map.value == b;
+	}
+	return false;
+}
+
+Type *alloc_type(TypeKind kind);
+
+// Returns the canonical type for the key, inserting 'new_type' if it does not exist yet.
+// If 'new_type' is nullptr, a new type is allocated only when needed
+Type *type_intern(TypeKind kind, Type *a, Type *b, i64 count, Type *new_type=nullptr) {
+	u64 hash = type_intern_hash(kind, a, b, count);
+	TypeInternShard *shard = &g_type_intern_shards[hash % TYPE_INTERN_SHARD_COUNT];
+	uintptr key = cast(uintptr)hash;
+
+	bool initialized = g_type_intern_initialized.load(std::memory_order_relaxed);
+	if (initialized) {
+		mutex_lock(&shard->mutex);
+		for (auto *e = multi_map_find_first(&shard->map, key); e != nullptr; e = multi_map_find_next(&shard->map, e)) {
+			if (type_intern_matches(e->value, kind, a, b, count)) {
+				mutex_unlock(&shard->mutex);
+				return e->value;
+			}
+		}
+	}
+
+	Type *t = new_type;
+	if (t == nullptr) {
+		t = alloc_type(kind);
+		switch (kind) {
+		case Type_Pointer:      t->Pointer.elem      = a; break;
+		case Type_MultiPointer: t->MultiPointer.elem = a; break;
+		case Type_Slice:        t->Slice.elem        = a; break;
+		case Type_DynamicArray: t->DynamicArray.elem = a; break;
+		case Type_Array:
+			t->Array.elem  = a;
+			t->Array.count = count;
+			break;
+		case Type_Map:
+			t->Map.key   = a;
+			t->Map.value = b;
+			break;
+		default:
+			GB_PANIC("Unsupported interned type kind %.*s", LIT(type_strings[kind]));
+			break;
+		}
+	}
+
+	if (initialized) {
+		multi_map_insert(&shard->map, key, t);
+		mutex_unlock(&shard->mutex);
+	}
+	return t;
 }
 
 bool type_ptr_set_exists(PtrSet<Type *> *s, Type *t) {
@@ -906,29 +1001,23 @@ Type *alloc_type_generic(Scope *scope, i64 id, String name, Type *specialized) {
 }
 
 Type *alloc_type_pointer(Type *elem) {
-	Type *t = alloc_type(Type_Pointer);
-	t->Pointer.elem = elem;
-	return t;
+	return type_intern(Type_Pointer, elem, nullptr, 0);
 }
 
 Type *alloc_type_multi_pointer(Type *elem) {
-	Type *t = alloc_type(Type_MultiPointer);
-	t->MultiPointer.elem = elem;
-	return t;
+	return type_intern(Type_MultiPointer, elem, nullptr, 0);
 }
 
 Type *alloc_type_array(Type *elem, i64 count, Type *generic_count = nullptr) {
-	if (generic_count != nullptr) {
+	if (generic_count != nullptr || count < 0) {
+		// NOTE: '[?]T' types have their count determined (and modified) later
 		Type *t = alloc_type(Type_Array);
 		t->Array.elem = elem;
 		t->Array.count = count;
 		t->Array.generic_count = generic_count;
 		return t;
 	}
-	Type *t = alloc_type(Type_Array);
-	t->Array.elem = elem;
-	t->Array.count = count;
-	return t;
+	return type_intern(Type_Array, elem, nullptr, count);
 }
 
 Type *alloc_type_matrix(Type *elem, i64 row_count, i64 column_count, Type *generic_row_count = nullptr, Type *generic_column_count = nullptr) {
@@ -965,15 +1054,11 @@ Type *alloc_type_enumerated_array(Type *elem, Type *index, ExactValue const *min
 
 
 Type *alloc_type_slice(Type *elem) {
-	Type *t = alloc_type(Type_Slice);
-	t->Array.elem = elem;
-	return t;
+	return type_intern(Type_Slice, elem, nullptr, 0);
 }
 
 Type *alloc_type_dynamic_array(Type *elem) {
-	Type *t = alloc_type(Type_DynamicArray);
-	t->DynamicArray.elem = elem;
-	return t;
+	return type_intern(Type_DynamicArray, elem, nullptr, 0);
 }
 
 
@@ -1074,13 +1159,23 @@ Type *alloc_type_proc(Scope *scope, Type *params, isize param_count, Type *resul
 bool is_type_valid_for_keys(Type *t);
 
 Type *alloc_type_map(i64 count, Type *key, Type *value) {
-	if (key != nullptr) {
-		GB_ASSERT(value != nullptr);
+	if (key == nullptr) {
+		Type *t = alloc_type(Type_Map);
+		t->Map.value = value;
+		return t;
 	}
-	Type *t = alloc_type(Type_Map);
-	t->Map.key   = key;
-	t->Map.value = value;
-	return t;
+	GB_ASSERT(value != nullptr);
+	return type_intern(Type_Map, key, value, 0);
+}
+
+// NOTE: Map types from type expressions are filled in place (to allow for recursive types),
+// so they can only be interned once their key and value are known
+Type *intern_type_map(Type *t) {
+	GB_ASSERT(t->kind == Type_Map);
+	if (t->Map.key == nullptr || t->Map.value == nullptr) {
+		return t;
+	}
+	return type_intern(Type_Map, t->Map.key, t->Map.value, 0, t);
 }
 
 Type *alloc_type_bit_set() {
@@ -2620,6 +2715,141 @@ bool are_types_identical_internal(Type *x, Type *y, bool check_tuple_names) {
 	return false;
 }
 
+u64 type_hash_mix(u64 h, u64 v) {
+	h ^= v + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+	return h;
+}
+
+u64 type_hash_structural_internal(Type *t, bool check_tuple_names, isize depth);
+
+// NOTE: A structural hash which is consistent with 'are_types_identical_internal',
+// i.e. if two types are identical, they will have the same hash (but not vice versa)
+u64 type_hash_structural(Type *t) {
+	return type_hash_structural_internal(t, false, 0);
+}
+u64 type_hash_structural_unique_tuples(Type *t) {
+	return type_hash_structural_internal(t, true, 0);
+}
+
+u64 type_hash_structural_internal(Type *t, bool check_tuple_names, isize depth) {
+	if (t == nullptr) {
+		return 0;
+	}
+	t = strip_type_aliasing(t);
+
+	u64 h = type_hash_mix(0, cast(u64)t->kind);
+	if (depth > 8) {
+		// NOTE: Bound the recursion, identical types will still agree up to this depth
+		return h;
+	}
+	depth += 1;
+
+	#define TYPE_HASH(x) type_hash_structural_internal((x), false, depth)
+
+	switch (t->kind) {
+	case Type_Generic:
+		return TYPE_HASH(t->Generic.specialized);
+
+	case Type_Basic:
+		return type_hash_mix(h, cast(u64)t->Basic.kind);
+
+	case Type_EnumeratedArray:
+		h = type_hash_mix(h, TYPE_HASH(t->EnumeratedArray.index));
+		return type_hash_mix(h, TYPE_HASH(t->EnumeratedArray.elem));
+
+	case Type_Array:
+		h = type_hash_mix(h, cast(u64)t->Array.count);
+		return type_hash_mix(h, TYPE_HASH(t->Array.elem));
+
+	case Type_Matrix:
+		h = type_hash_mix(h, cast(u64)t->Matrix.row_count);
+		h = type_hash_mix(h, cast(u64)t->Matrix.column_count);
+		return type_hash_mix(h, TYPE_HASH(t->Matrix.elem));
+
+	case Type_DynamicArray:
+		return type_hash_mix(h, TYPE_HASH(t->DynamicArray.elem));
+
+	case Type_Slice:
+		return type_hash_mix(h, TYPE_HASH(t->Slice.elem));
+
+	case Type_BitSet:
+		h = type_hash_mix(h, TYPE_HASH(t->BitSet.elem));
+		h = type_hash_mix(h, TYPE_HASH(t->BitSet.underlying));
+		h = type_hash_mix(h, cast(u64)t->BitSet.lower);
+		return type_hash_mix(h, cast(u64)t->BitSet.upper);
+
+	case Type_Union:
+		h = type_hash_mix(h, cast(u64)t->Union.variants.count);
+		h = type_hash_mix(h, cast(u64)t->Union.custom_align);
+		h = type_hash_mix(h, cast(u64)t->Union.kind);
+		for_array(i, t->Union.variants) {
+			h = type_hash_mix(h, TYPE_HASH(t->Union.variants[i]));
+		}
+		return h;
+
+	case Type_Struct:
+		h = type_hash_mix(h, cast(u64)t->Struct.is_raw_union);
+		h = type_hash_mix(h, cast(u64)t->Struct.fields.count);
+		h = type_hash_mix(h, cast(u64)t->Struct.is_packed);
+		h = type_hash_mix(h, cast(u64)t->Struct.custom_align);
+		h = type_hash_mix(h, cast(u64)t->Struct.soa_kind);
+		h = type_hash_mix(h, cast(u64)t->Struct.soa_count);
+		h = type_hash_mix(h, TYPE_HASH(t->Struct.soa_elem));
+		for_array(i, t->Struct.fields) {
+			Entity *f = t->Struct.fields[i];
+			h = type_hash_mix(h, cast(u64)f->kind);
+			h = type_hash_mix(h, TYPE_HASH(f->type));
+			h = type_hash_mix(h, fnv64a(f->token.string.text, f->token.string.len));
+			h = type_hash_mix(h, cast(u64)(f->flags&EntityFlags_IsSubtype));
+		}
+		return h;
+
+	case Type_Pointer:
+		return type_hash_mix(h, TYPE_HASH(t->Pointer.elem));
+
+	case Type_MultiPointer:
+		return type_hash_mix(h, TYPE_HASH(t->MultiPointer.elem));
+
+	case Type_Named:
+		return type_hash_mix(h, cast(u64)cast(uintptr)t->Named.type_name);
+
+	case Type_Tuple:
+		h = type_hash_mix(h, cast(u64)t->Tuple.variables.count);
+		h = type_hash_mix(h, cast(u64)t->Tuple.is_packed);
+		for_array(i, t->Tuple.variables) {
+			Entity *v = t->Tuple.variables[i];
+			h = type_hash_mix(h, cast(u64)v->kind);
+			h = type_hash_mix(h, TYPE_HASH(v->type));
+			if (check_tuple_names) {
+				h = type_hash_mix(h, fnv64a(v->token.string.text, v->token.string.len));
+			}
+		}
+		return h;
+
+	case Type_Proc:
+		h = type_hash_mix(h, cast(u64)t->Proc.calling_convention);
+		h = type_hash_mix(h, cast(u64)t->Proc.c_vararg);
+		h = type_hash_mix(h, cast(u64)t->Proc.variadic);
+		h = type_hash_mix(h, cast(u64)t->Proc.diverging);
+		h = type_hash_mix(h, cast(u64)t->Proc.optional_ok);
+		h = type_hash_mix(h, TYPE_HASH(t->Proc.params));
+		return type_hash_mix(h, TYPE_HASH(t->Proc.results));
+
+	case Type_Map:
+		h = type_hash_mix(h, TYPE_HASH(t->Map.key));
+		return type_hash_mix(h, TYPE_HASH(t->Map.value));
+
+	case Type_SimdVector:
+		h = type_hash_mix(h, cast(u64)t->SimdVector.count);
+		return type_hash_mix(h, TYPE_HASH(t->SimdVector.elem));
+	}
+
+	#undef TYPE_HASH
+
+	// NOTE: Everything else is only ever identical to itself (e.g. enums)
+	return type_hash_mix(h, cast(u64)cast(uintptr)t);
+}
+
 Type *default_type(Type *type) {
 	if (type == nullptr) {
 		return t_invalid;
@@ -12,6 +12,11 @@ build\test_issue
 ..\..\odin build test_issue_1592.odin %COMMON% -file
 build\test_issue
 
+rem The same column on the first and second lines must be reported as the same column
+..\..\odin check test_error_column.odin -file > build\test_error_column.txt 2>&1
+findstr /C:"test_error_column.odin(1:33) Undeclared name: undeclared_1" build\test_error_column.txt || exit /b
+findstr /C:"test_error_column.odin(2:33) Undeclared name: undeclared_2" build\test_error_column.txt || exit /b
+
 @echo off
 
 rmdir /S /Q build
@@ -13,6 +13,11 @@ $ODIN build test_issue_829.odin $COMMON -file
 $ODIN build test_issue_1592.odin $COMMON -file
 ./build/test_issue
 
+# The same column on the first and second lines must be reported as the same column
+$ODIN check test_error_column.odin -file > build/test_error_column.txt 2>&1 || true
+grep -F "test_error_column.odin(1:33) Undeclared name: undeclared_1" build/test_error_column.txt
+grep -F "test_error_column.odin(2:33) Undeclared name: undeclared_2" build/test_error_column.txt
+
 set +x
 
 rm -rf build
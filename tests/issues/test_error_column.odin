@@ -0,0 +1,4 @@
+package test_error_column; x := undeclared_1
+                           y := undeclared_2
+
+// Checks that diagnostics on the first line use the same column base as every other line, see run.sh